@@ -0,0 +1,206 @@
+#include "alloc_tracker.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__has_include)
+    #if __has_include(<execinfo.h>)
+        #include <execinfo.h>
+        #define ALLOC_HAS_BACKTRACE
+    #endif
+#endif
+
+const int BACKTRACE_DEPTH = 32;
+
+namespace {
+    // Plain thread locals, so using them from operator new doesn't allocate
+    thread_local const char* currentTag = "Untagged";
+    thread_local bool isCurrentTagChecked = true;
+    thread_local bool isInHook = false; // Allocations made while reporting aren't counted
+    thread_local AllocationStats threadStats;
+}
+
+AllocationTracker& AllocationTracker::getInstance() {
+    static AllocationTracker instance;
+    return instance;
+}
+
+bool AllocationTracker::isCompiledIn() {
+#ifdef AB_ALLOC_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Moves the counts of the current frame to the previous frame, called by the main thread
+void AllocationTracker::beginFrame() {
+    frameStats_ = AllocationStats();
+    frameTagCount_ = 0;
+    for (auto& counters : tags_) {
+        const char* name = counters.name.load(std::memory_order_acquire);
+        if (name == nullptr) {
+            break; // Tags are added in order, the rest are unused
+        }
+        TagStats& tagStats = frameTags_[frameTagCount_++];
+        tagStats.name = name;
+        tagStats.stats.count = counters.count.exchange(0, std::memory_order_relaxed);
+        tagStats.stats.bytes = counters.bytes.exchange(0, std::memory_order_relaxed);
+        tagStats.stats.frees = counters.frees.exchange(0, std::memory_order_relaxed);
+        frameStats_.count += tagStats.stats.count;
+        frameStats_.bytes += tagStats.stats.bytes;
+        frameStats_.frees += tagStats.stats.frees;
+    }
+}
+
+const AllocationStats& AllocationTracker::getFrameStats() const {
+    return frameStats_;
+}
+
+size_t AllocationTracker::getTagCount() const {
+    return frameTagCount_;
+}
+
+const TagStats& AllocationTracker::getTagStats(size_t index) const {
+    return frameTags_[index];
+}
+
+void AllocationTracker::setStrict(bool isStrict) {
+    isStrict_ = isStrict;
+}
+
+bool AllocationTracker::isStrict() const {
+    return isStrict_;
+}
+
+// The game is in its steady state while a level runs after the first shot, strict mode only reports allocations then
+void AllocationTracker::setSteadyState(bool isSteadyState) {
+    isSteadyState_.store(isSteadyState, std::memory_order_relaxed);
+}
+
+void AllocationTracker::recordAllocation(size_t bytes) {
+    if (isInHook) {
+        return;
+    }
+    Counters& counters = getCounters(currentTag);
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+    threadStats.count++;
+    threadStats.bytes += bytes;
+    if (isCurrentTagChecked && isStrict_.load(std::memory_order_relaxed) && isSteadyState_.load(std::memory_order_relaxed)) {
+        isInHook = true;
+        report(bytes, currentTag);
+        isInHook = false;
+    }
+}
+
+void AllocationTracker::recordFree() {
+    if (isInHook) {
+        return;
+    }
+    getCounters(currentTag).frees.fetch_add(1, std::memory_order_relaxed);
+    threadStats.frees++;
+}
+
+// Finds the counters of the tag, or claims the first unused ones for it
+AllocationTracker::Counters& AllocationTracker::getCounters(const char* tag) {
+    for (auto& counters : tags_) {
+        const char* name = counters.name.load(std::memory_order_acquire);
+        if (name == nullptr) {
+            if (counters.name.compare_exchange_strong(name, tag, std::memory_order_acq_rel)) {
+                return counters;
+            }
+            // Another thread claimed the counters, name now holds its tag
+        }
+        if (name == tag || std::strcmp(name, tag) == 0) {
+            return counters;
+        }
+    }
+    return tags_.back();
+}
+
+void AllocationTracker::report(size_t bytes, const char* tag) const {
+    std::fprintf(stderr, "Allocation of %zu bytes in %s during the steady state\n", bytes, tag);
+#ifdef ALLOC_HAS_BACKTRACE
+    void* frames[BACKTRACE_DEPTH];
+    int depth = backtrace(frames, BACKTRACE_DEPTH);
+    backtrace_symbols_fd(frames, depth, 2);
+#endif
+}
+
+AllocationTag::AllocationTag(const char* name, bool isChecked) : previousName_(currentTag), wasChecked_(isCurrentTagChecked) {
+    currentTag = name;
+    // Unchecked tags stay unchecked for nested tags
+    isCurrentTagChecked = isCurrentTagChecked && isChecked;
+}
+
+AllocationTag::~AllocationTag() {
+    currentTag = previousName_;
+    isCurrentTagChecked = wasChecked_;
+}
+
+AllocationScope::AllocationScope() : start_(threadStats) {}
+
+AllocationStats AllocationScope::getStats() const {
+    AllocationStats stats;
+    stats.count = threadStats.count - start_.count;
+    stats.bytes = threadStats.bytes - start_.bytes;
+    stats.frees = threadStats.frees - start_.frees;
+    return stats;
+}
+
+#ifdef AB_ALLOC_TRACKING
+// Replaceable global allocation functions, the aligned variants are left to the standard library
+void* operator new(size_t size) {
+    void* pointer = std::malloc(size > 0 ? size : 1);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    AllocationTracker::getInstance().recordAllocation(size);
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    void* pointer = std::malloc(size > 0 ? size : 1);
+    if (pointer != nullptr) {
+        AllocationTracker::getInstance().recordAllocation(size);
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer != nullptr) {
+        AllocationTracker::getInstance().recordFree();
+        std::free(pointer);
+    }
+}
+
+void operator delete[](void* pointer) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    operator delete(pointer);
+}
+#endif
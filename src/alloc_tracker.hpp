@@ -0,0 +1,120 @@
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+/*
+ * Counts heap allocations made through the global operator new, per frame and per subsystem tag.
+ *
+ * ALLOC_TAG("name") attributes the allocations of the current thread to the tag until the end of the enclosing scope.
+ * ALLOC_TAG_UNCHECKED("name") does the same, but strict mode doesn't report the allocations, e.g. for debug overlays.
+ * ASSERT_NO_ALLOCATIONS(statement) asserts that the statement doesn't allocate on the current thread.
+ * The operator new hook is compiled in only with the AB_ALLOC_TRACKING CMake option, without it all counts stay at 0.
+ * Box2D allocates with malloc through b2Alloc, so its allocations aren't counted.
+ */
+#ifdef AB_ALLOC_TRACKING
+    #define ALLOC_CONCAT_IMPL(a, b) a##b
+    #define ALLOC_CONCAT(a, b) ALLOC_CONCAT_IMPL(a, b)
+    #define ALLOC_TAG(name) AllocationTag ALLOC_CONCAT(allocationTag_, __LINE__)(name)
+    #define ALLOC_TAG_UNCHECKED(name) AllocationTag ALLOC_CONCAT(allocationTag_, __LINE__)(name, false)
+    #define ASSERT_NO_ALLOCATIONS(statement) do { \
+            AllocationScope allocationScope; \
+            statement; \
+            assert(allocationScope.getStats().count == 0 && #statement " allocated"); \
+        } while (0)
+#else
+    #define ALLOC_TAG(name)
+    #define ALLOC_TAG_UNCHECKED(name)
+    #define ASSERT_NO_ALLOCATIONS(statement) statement
+#endif
+
+const size_t ALLOCATION_TAG_COUNT = 32; // Tags after the last one are counted in the last one
+
+/**
+ * @brief Allocation counts over some period
+ *
+ * @param count Number of allocations
+ * @param bytes Total size of the allocations in bytes
+ * @param frees Number of deallocations
+ */
+struct AllocationStats {
+    size_t count = 0;
+    size_t bytes = 0;
+    size_t frees = 0;
+};
+
+struct TagStats {
+    const char* name = nullptr;
+    AllocationStats stats;
+};
+
+/**
+ * @brief Singleton that collects the counts of the operator new hook
+ *
+ * Allocations from all threads are counted, frames are delimited by the main thread calling beginFrame.
+ * In strict mode every checked allocation made while the game is in its steady state is written to stderr
+ * with a stack trace, where the platform supports it.
+ */
+class AllocationTracker {
+    public:
+        static AllocationTracker& getInstance();
+        static bool isCompiledIn();
+        void beginFrame();
+        const AllocationStats& getFrameStats() const;
+        size_t getTagCount() const;
+        const TagStats& getTagStats(size_t index) const;
+        void setStrict(bool isStrict);
+        bool isStrict() const;
+        void setSteadyState(bool isSteadyState);
+        // Called from the global operator new and delete
+        void recordAllocation(size_t bytes);
+        void recordFree();
+    private:
+        AllocationTracker() = default;
+        AllocationTracker(const AllocationTracker&) = delete;
+        AllocationTracker& operator=(const AllocationTracker&) = delete;
+        struct Counters {
+            std::atomic<const char*> name{nullptr};
+            std::atomic<size_t> count{0};
+            std::atomic<size_t> bytes{0};
+            std::atomic<size_t> frees{0};
+        };
+        std::array<Counters, ALLOCATION_TAG_COUNT> tags_; // Counts of the current frame
+        std::array<TagStats, ALLOCATION_TAG_COUNT> frameTags_; // Counts of the previous frame
+        size_t frameTagCount_ = 0;
+        AllocationStats frameStats_;
+        std::atomic<bool> isStrict_{false};
+        std::atomic<bool> isSteadyState_{false};
+        Counters& getCounters(const char* tag);
+        void report(size_t bytes, const char* tag) const;
+};
+
+/**
+ * @brief Attributes the allocations of the current thread to a tag until destruction
+ */
+class AllocationTag {
+    public:
+        AllocationTag(const char* name, bool isChecked = true);
+        ~AllocationTag();
+        AllocationTag(const AllocationTag&) = delete;
+        AllocationTag& operator=(const AllocationTag&) = delete;
+    private:
+        const char* previousName_;
+        bool wasChecked_;
+};
+
+/**
+ * @brief Counts the allocations made by the current thread since construction
+ */
+class AllocationScope {
+    public:
+        AllocationScope();
+        AllocationStats getStats() const;
+    private:
+        AllocationStats start_;
+};
+
+#endif // ALLOC_TRACKER_HPP
@@ -0,0 +1,106 @@
+#include "audio_service.hpp"
+#include "resource_manager.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+AudioService::AudioService() {
+    loadSounds();
+}
+
+AudioService& AudioService::getInstance() {
+    static AudioService instance;
+    return instance;
+}
+
+void AudioService::loadSounds() {
+    std::string path = utils::getExecutablePath() + "/assets/data/impact_sounds.json";
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    json soundsJson;
+    file >> soundsJson;
+    file.close();
+    ResourceManager& resourceManager = ResourceManager::getInstance();
+    for (const auto& [key, soundJson] : soundsJson.at("impacts").items()) {
+        if (key.size() != 1) {
+            throw std::runtime_error("Invalid impact sound " + key + ". Should be one of W, P, B");
+        }
+        ImpactSound sound;
+        sound.buffer = &resourceManager.getSoundBuffer(soundJson.at("file").get<std::string>());
+        soundJson.at("priority").get_to(sound.priority);
+        soundJson.at("volume").get_to(sound.volume);
+        soundJson.at("fullImpulse").get_to(sound.fullImpulse);
+        sounds_[key[0]] = sound;
+    }
+}
+
+// Starts a new frame of impacts, the listener position is in SFML coordinates
+void AudioService::beginFrame(const sf::Vector2f& listenerPosition) {
+    listenerPosition_ = listenerPosition;
+    playedCount_ = 0;
+}
+
+void AudioService::playImpact(const ImpactEvent& impact) {
+    if (playedCount_ >= AUDIO_PLAYS_PER_FRAME) {
+        return; // Rate limit of the frame reached
+    }
+    auto it = sounds_.find(impact.type);
+    if (it == sounds_.end()) {
+        return;
+    }
+    const ImpactSound& sound = it->second;
+    for (size_t i = 0; i < playedCount_; i++) {
+        sf::Vector2f offset = played_[i].position - impact.position;
+        if (played_[i].type == impact.type && offset.x * offset.x + offset.y * offset.y < AUDIO_DEDUPE_DISTANCE * AUDIO_DEDUPE_DISTANCE) {
+            return; // Same sound already started at the same place this frame
+        }
+    }
+    sf::Vector2f offset = impact.position - listenerPosition_;
+    float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+    float attenuation = std::max(0.f, 1.f - distance / AUDIO_MAX_DISTANCE);
+    float volume = sound.volume * std::min(1.f, impact.impulse / sound.fullImpulse) * attenuation;
+    if (volume < AUDIO_MIN_VOLUME) {
+        return;
+    }
+    Voice* voice = acquireVoice(sound.priority, distance);
+    if (voice == nullptr) {
+        return; // Every voice plays something more important
+    }
+    voice->sound.setBuffer(*sound.buffer);
+    voice->sound.setVolume(volume);
+    voice->sound.play();
+    voice->priority = sound.priority;
+    voice->distance = distance;
+    played_[playedCount_++] = impact;
+}
+
+void AudioService::stopAll() {
+    for (auto& voice : voices_) {
+        voice.sound.stop();
+    }
+}
+
+// Free voice, or the voice of the least important sound if it is less important than the new one
+AudioService::Voice* AudioService::acquireVoice(int priority, float distance) {
+    Voice* victim = nullptr;
+    for (auto& voice : voices_) {
+        if (voice.sound.getStatus() == sf::Sound::Stopped) {
+            return &voice;
+        }
+        if (victim == nullptr || voice.priority < victim->priority
+            || (voice.priority == victim->priority && voice.distance > victim->distance)) {
+            victim = &voice;
+        }
+    }
+    if (victim->priority > priority || (victim->priority == priority && victim->distance <= distance)) {
+        return nullptr;
+    }
+    victim->sound.stop();
+    return victim;
+}
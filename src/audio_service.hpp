@@ -0,0 +1,63 @@
+#ifndef AUDIO_SERVICE_HPP
+#define AUDIO_SERVICE_HPP
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <unordered_map>
+#include "world_snapshot.hpp"
+
+const size_t AUDIO_VOICE_COUNT = 12; // Hard ceiling of impact sounds playing at once
+const size_t AUDIO_PLAYS_PER_FRAME = 3; // Impact sounds started per frame, further impacts of the frame are dropped
+const float AUDIO_DEDUPE_DISTANCE = 60.f; // Impacts of the same sound closer than this in pixels within a frame play once
+const float AUDIO_MAX_DISTANCE = 2500.f; // Pixels from the listener at which impacts become silent
+const float AUDIO_MIN_VOLUME = 2.f; // Quieter impacts aren't worth a voice
+
+/**
+ * @brief Sound of an impact type
+ *
+ * @param buffer Buffer of the sound, owned by the ResourceManager
+ * @param priority Voices of lower priority sounds are stolen first
+ * @param volume Volume of the sound at full impulse, 0 - 100
+ * @param fullImpulse Impulse at which the sound plays at full volume, weaker impacts are quieter
+ */
+struct ImpactSound {
+    const sf::SoundBuffer* buffer = nullptr;
+    int priority = 0;
+    float volume = 100.f;
+    float fullImpulse = 1.f;
+};
+
+/**
+ * @brief Plays the impact sounds from a fixed pool of voices
+ *
+ * The sounds are defined in assets/data/impact_sounds.json. Volume scales with the impulse and falls off with the distance
+ * from the listener, usually the camera center. When every voice is busy, the voice of the lowest priority sound farthest
+ * from the listener is stolen if the new impact is more important. At most AUDIO_PLAYS_PER_FRAME sounds start per frame
+ * and near-identical impacts of a frame play once, so the cost of a frame stays constant however many contacts there are.
+ * Used by the main thread.
+ */
+class AudioService {
+    public:
+        static AudioService& getInstance();
+        AudioService(const AudioService&) = delete;
+        AudioService& operator=(const AudioService&) = delete;
+        void beginFrame(const sf::Vector2f& listenerPosition);
+        void playImpact(const ImpactEvent& impact);
+        void stopAll();
+    private:
+        struct Voice {
+            sf::Sound sound;
+            int priority = 0;
+            float distance = 0;
+        };
+        AudioService();
+        void loadSounds();
+        Voice* acquireVoice(int priority, float distance);
+        std::unordered_map<char, ImpactSound> sounds_;
+        std::array<Voice, AUDIO_VOICE_COUNT> voices_;
+        std::array<ImpactEvent, AUDIO_PLAYS_PER_FRAME> played_; // Impacts started this frame, for deduplication
+        size_t playedCount_ = 0;
+        sf::Vector2f listenerPosition_;
+};
+
+#endif // AUDIO_SERVICE_HPP
@@ -1,6 +1,7 @@
 #include "bird.hpp"
 #include <iostream>
 #include "utils.hpp"
+#include "collision_filter.hpp"
 
 Bird::Bird(b2Body *body, std::string textureFile, Bird::Type birdType, float radius) : 
 Object(body, Object::Type::Bird, textureFile, 100.f, true), birdType_(birdType), radius_(radius) {
@@ -12,6 +13,7 @@ Object(body, Object::Type::Bird, textureFile, 100.f, true), birdType_(birdType),
 
 MiniBird::MiniBird(b2Body *body, float radius) :
 Object(body, Object::Type::MiniBird, "/assets/images/blue_bird.png", 50.f, true) {
+    damageMultiplier_ = MINI_BIRD_DAMAGE_MULTIPLIER;
     int width = sprite_.getTextureRect().width;
     int height = sprite_.getTextureRect().height;
     sprite_.setScale(radius * SCALE * 2.f / (1.f * width), radius * SCALE * 2.f / (1.f * height));
@@ -22,12 +24,18 @@ Bird::Type Bird::getBirdType() const {
     return birdType_;
 }
 
-void Bird::draw(sf::RenderWindow &window) const {
+void Bird::draw(RenderQueue& window) const {
     if (isLaunched_) {
         window.draw(sprite_);
     }
 }
 
+void Bird::captureSprites(std::vector<sf::Sprite>& sprites) const {
+    if (isLaunched_) {
+        sprites.push_back(sprite_);
+    }
+}
+
 bool Bird::isLaunched() const {
     return isLaunched_;
 }
@@ -76,6 +84,24 @@ char GreenBird::getTypeAsChar() const {
     return 'G';
 }
 
+// Uses the red bird texture darkened, as there is no texture of its own
+ExplosiveBird::ExplosiveBird(b2Body *body, float radius) : Bird(body, "/assets/images/red_bird.png", Bird::Type::Explosive, radius) {
+    sprite_.setColor(EXPLOSIVE_BIRD_COLOR);
+}
+
+char ExplosiveBird::getTypeAsChar() const {
+    return 'X';
+}
+
+// The bird is destroyed by its power, the World sets off its blast when removing it
+void ExplosiveBird::usePower() {
+    if (isPowerUsed_ || !isLaunched_) {
+        return;
+    }
+    isPowerUsed_ = true;
+    isDestroyed_ = true;
+}
+
 bool Bird::shouldRemove() const {
     if (isDestroyed()) {
         return true;
@@ -145,6 +171,7 @@ void BlueBird::createMiniBird(b2Vec2 position) {
     fixtureDef.density = 1;
     fixtureDef.friction = 1;
     fixtureDef.restitution = 0.4;
+    fixtureDef.filter = getCollisionFilter(Object::Type::MiniBird);
 
     auto miniBird = std::make_unique<MiniBird>(new_body, circle.m_radius);
     fixtureDef.userData.pointer = reinterpret_cast<uintptr_t>(miniBird.get());
@@ -176,7 +203,7 @@ void BlueBird::usePower() {
     }
 }
 
-void BlueBird::draw(sf::RenderWindow &window) const {
+void BlueBird::draw(RenderQueue& window) const {
     Bird::draw(window);
     if (isPowerUsed_) {
         for (auto& miniBird : miniBirds_) {
@@ -185,6 +212,33 @@ void BlueBird::draw(sf::RenderWindow &window) const {
     }
 }
 
+void BlueBird::captureSprites(std::vector<sf::Sprite>& sprites) const {
+    Bird::captureSprites(sprites);
+    if (isPowerUsed_) {
+        for (auto& miniBird : miniBirds_) {
+            miniBird->captureSprites(sprites);
+        }
+    }
+}
+
+// Mini birds are created by the power after the state was saved, so they are destroyed instead of restored
+void BlueBird::restoreState(const ObjectState& state) {
+    clearMiniBirds();
+    Bird::restoreState(state);
+}
+
+void BlueBird::disable() {
+    clearMiniBirds();
+    Bird::disable();
+}
+
+void BlueBird::clearMiniBirds() {
+    for (auto& miniBird : miniBirds_) {
+        miniBird->getBody()->GetWorld()->DestroyBody(miniBird->getBody());
+    }
+    miniBirds_.clear();
+}
+
 std::list<std::unique_ptr<MiniBird>>::iterator BlueBird::removeDestroyedMiniBird(std::list<std::unique_ptr<MiniBird>>::iterator it) {
     (*it)->getBody()->GetWorld()->DestroyBody((*it)->getBody());
     it = miniBirds_.erase(it);
@@ -198,6 +252,12 @@ void GreenBird::usePower() {
         return;
     }
     isPowerUsed_ = true;
+    damageMultiplier_ = GREEN_BIRD_POWER_DAMAGE_MULTIPLIER;
+}
+
+void GreenBird::restoreState(const ObjectState& state) {
+    Bird::restoreState(state);
+    damageMultiplier_ = isPowerUsed_ ? GREEN_BIRD_POWER_DAMAGE_MULTIPLIER : 1;
 }
 
 void GreenBird::handleKeyPress(const sf::Keyboard::Key& code) {
@@ -237,52 +297,24 @@ void GreenBird::handleKeyPress(const sf::Keyboard::Key& code) {
     }
 }
 
-void Bird::handleCollision(Object* objectB) {
-    if (objectB->getType() == Object::Type::MiniBird) {
-        return; // Bird gets no damage from MiniBirds
-    }
-    float damage = objectB->getBody()->GetLinearVelocity().LengthSquared();
-    switch (objectB->getType()) {
-        case Object::Type::Pig:
-            damage = damage * 0.5;
-            break;
-        case Object::Type::Wall:
-            damage = damage * 1.5f;
-            break;
-        case Object::Type::Ground:
-            if (prevY_ > 0.95f) {
-                damage = body_->GetLinearVelocity().Length() * 0.1f;
-            } else {
-                damage = 0;
-            }
-            break;
-        default:
-            break;
-    }
-    
-    if (damage <= 0.1f) {
-        return;
-    }
-    health_ -= damage * this->getDamageMultiplier();
-    if (health_ <= 0) {
-        isDestroyed_ = true;
-    }
-}
-
 bool Bird::getIsPowerUsed() const {
     return isPowerUsed_;
 }
 
-int Bird::getDamageMultiplier() const {
-    return 1;
+void Bird::saveState(ObjectState& state) const {
+    Object::saveState(state);
+    state.isLaunched = isLaunched_;
+    state.isPowerUsed = isPowerUsed_;
 }
 
-int GreenBird::getDamageMultiplier() const {
-    if (isPowerUsed_) {
-        return 10;
-    } else {
-        return 1;
-    }
+// The flight time isn't saved, a restored launched bird starts its flight time again
+void Bird::restoreState(const ObjectState& state) {
+    isLaunched_ = state.isLaunched;
+    isPowerUsed_ = state.isPowerUsed;
+    isPaused_ = false;
+    pausedTime_ = 0;
+    pressClock_.restart();
+    Object::restoreState(state);
 }
 
 char MiniBird::getTypeAsChar() const {
@@ -292,35 +324,3 @@ char MiniBird::getTypeAsChar() const {
 bool MiniBird::shouldRemove() const {
     return isDestroyed() || isOutOfBounds();
 }
-
-void MiniBird::handleCollision(Object* objectB) {
-    if (objectB->getType() == Object::Type::MiniBird
-        || objectB->getType() == Object::Type::Bird
-        || objectB->getType() == Object::Type::Ground
-    ) {
-        return; // MiniBirds don't damage each other and don't get damaged by other birds
-    }
-    float damage = objectB->getBody()->GetLinearVelocity().LengthSquared();
-    switch (objectB->getType()) {
-        case Object::Type::Pig:
-            damage = damage * 2.f;
-            break;
-        case Object::Type::Wall:
-            damage = damage * 2.f;
-            break;
-        default:
-            break;
-    }
-    
-    if (damage <= 0.1f) {
-        return;
-    }
-    health_ -= damage * this->getDamageMultiplier();
-    if (health_ <= 0) {
-        isDestroyed_ = true;
-    }
-}
-
-int MiniBird::getDamageMultiplier() const {
-    return 2;
-}
\ No newline at end of file
@@ -5,6 +5,10 @@
 #include <list>
 #include <memory>
 
+const sf::Color EXPLOSIVE_BIRD_COLOR(70, 70, 70);
+const int MINI_BIRD_DAMAGE_MULTIPLIER = 2;
+const int GREEN_BIRD_POWER_DAMAGE_MULTIPLIER = 10; // Damage multiplier of a GreenBird while its power is used
+
 /**
 * @brief MiniBird class, a smaller projectile of the original bird class. Only used by BlueBird when it uses its power
 */
@@ -13,8 +17,6 @@ class MiniBird : public Object {
         MiniBird(b2Body *body, float radius);
         char getTypeAsChar() const override;
         bool shouldRemove() const override;
-        void handleCollision(Object* objectB) override;
-        int getDamageMultiplier() const override;
 };
 
 /**
@@ -26,15 +28,15 @@ class Bird : public Object {
             Red,
             Blue,
             Green,
+            Explosive,
         };
         Bird(b2Body *body, std::string textureFile, Type birdType, float radius);
         virtual char getTypeAsChar() const override = 0;
         virtual void usePower() = 0;
-        virtual void draw(sf::RenderWindow &window) const override;
+        virtual void draw(RenderQueue& window) const override;
+        virtual void captureSprites(std::vector<sf::Sprite>& sprites) const override;
         virtual void update() override;
-        virtual void handleCollision(Object* objectB) override;
         virtual void handleKeyPress(const sf::Keyboard::Key& code) {};
-        virtual int getDamageMultiplier() const override;
         ~Bird() override = default;
         Type getBirdType() const;
         bool isLaunched() const;
@@ -44,6 +46,8 @@ class Bird : public Object {
         bool shouldRemove() const override;
         float getActiveTime() const;
         bool getIsPowerUsed() const;
+        void saveState(ObjectState& state) const override;
+        void restoreState(const ObjectState& state) override;
         protected:
             Type birdType_;
             float radius_;
@@ -72,18 +76,19 @@ class BlueBird : public Bird {
     public:
         BlueBird(b2Body *body, float radius);
         ~BlueBird() override {
-            for (auto& miniBird : miniBirds_) {
-                miniBird->getBody()->GetWorld()->DestroyBody(miniBird->getBody());
-            }
-            miniBirds_.clear();
+            clearMiniBirds();
         }
-        void draw(sf::RenderWindow &window) const override;
+        void draw(RenderQueue& window) const override;
+        void captureSprites(std::vector<sf::Sprite>& sprites) const override;
         char getTypeAsChar() const override;
         void update() override;
         void usePower() override;
+        void restoreState(const ObjectState& state) override;
+        void disable() override;
         std::list<std::unique_ptr<MiniBird>>::iterator removeDestroyedMiniBird(std::list<std::unique_ptr<MiniBird>>::iterator it);
     private:
         void createMiniBird(b2Vec2 position);
+        void clearMiniBirds();
         std::list<std::unique_ptr<MiniBird>> miniBirds_;
 };
 
@@ -96,9 +101,17 @@ class GreenBird : public Bird {
         char getTypeAsChar() const override;
         void usePower() override;
         void handleKeyPress(const sf::Keyboard::Key& code) override;
-        int getDamageMultiplier() const override;
+        void restoreState(const ObjectState& state) override;
 };
 
-
+/**
+ * @brief ExplosiveBird class inherits from Bird class, bird that explodes when its power is used, pushing and damaging everything around it
+ */
+class ExplosiveBird : public Bird {
+    public:
+        ExplosiveBird(b2Body *body, float radius);
+        char getTypeAsChar() const override;
+        void usePower() override;
+};
 
 #endif // BIRD_HPP
\ No newline at end of file
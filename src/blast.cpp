@@ -0,0 +1,220 @@
+#include "blast.hpp"
+#include "utils.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+float BlastType::getFalloff(float distance) const {
+    if (falloff.empty()) {
+        return std::max(0.f, 1.f - distance); // Linear falloff if the data doesn't define a curve
+    }
+    if (distance <= falloff.front().distance) {
+        return falloff.front().factor;
+    }
+    for (size_t i = 1; i < falloff.size(); i++) {
+        const FalloffPoint& previous = falloff[i - 1];
+        const FalloffPoint& next = falloff[i];
+        if (distance <= next.distance) {
+            float t = (distance - previous.distance) / std::max(next.distance - previous.distance, b2_epsilon);
+            return previous.factor + (next.factor - previous.factor) * t;
+        }
+    }
+    return falloff.back().factor;
+}
+
+BlastEngine::BlastEngine() {
+    query_.fixtures.reserve(BLAST_HIT_CAPACITY);
+    hits_.reserve(BLAST_HIT_CAPACITY);
+    loadTypes();
+}
+
+void BlastEngine::loadTypes() {
+    std::string path = utils::getExecutablePath() + "/assets/data/blasts.json";
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    json blastsJson;
+    file >> blastsJson;
+    file.close();
+    mergeDistance_ = blastsJson.value("mergeDistance", 0.f);
+    for (const auto& [key, typeJson] : blastsJson.at("types").items()) {
+        if (key.size() != 1) {
+            throw std::runtime_error("Invalid blast type " + key + ". Should be an object type character, e.g. X, P or W");
+        }
+        BlastType type;
+        typeJson.at("radius").get_to(type.radius);
+        typeJson.at("impulse").get_to(type.impulse);
+        typeJson.at("damage").get_to(type.damage);
+        type.occludedFactor = typeJson.value("occludedFactor", 0.f);
+        for (const auto& point : typeJson.value("falloff", json::array())) {
+            type.falloff.push_back({point.at(0).get<float>(), point.at(1).get<float>()});
+        }
+        std::sort(type.falloff.begin(), type.falloff.end(), [](const FalloffPoint& a, const FalloffPoint& b) {
+            return a.distance < b.distance;
+        });
+        types_[key[0]] = type;
+    }
+}
+
+// Blast set off when an object of the type is destroyed, nullptr if the type doesn't explode
+const BlastType* BlastEngine::getType(char objectType) const {
+    auto it = types_.find(objectType);
+    return it != types_.end() ? &it->second : nullptr;
+}
+
+// Queues a blast for the next step, a blast close to a pending one is merged into it.
+// When the queue is full, only a blast overlapping its nearest pending blast is merged, others wait one more step.
+void BlastEngine::addBlast(const b2Vec2& center, const BlastType& type) {
+    Blast blast = {center, type.radius, type.impulse, type.damage, &type};
+    Blast* nearest = nullptr;
+    float nearestDistance = 0;
+    for (size_t i = 0; i < pendingCount_; i++) {
+        float distance = b2Distance(pending_[i].center, center);
+        if (nearest == nullptr || distance < nearestDistance) {
+            nearest = &pending_[i];
+            nearestDistance = distance;
+        }
+    }
+    bool isClose = nearest != nullptr && nearestDistance <= mergeDistance_;
+    if (!isClose && pendingCount_ < BLAST_CAPACITY) {
+        pending_[pendingCount_++] = blast;
+        return;
+    }
+    if (!isClose && nearestDistance > nearest->radius + blast.radius) {
+        // Blasts that don't fit in the deferred queue either are dropped
+        if (deferredCount_ < BLAST_CAPACITY) {
+            deferred_[deferredCount_++] = blast;
+        }
+        return;
+    }
+    // The merged blast is centered by damage and covers both blasts, the stronger blast decides the falloff
+    float weight = blast.damage / std::max(blast.damage + nearest->damage, b2_epsilon);
+    nearest->center = (1.f - weight) * nearest->center + weight * blast.center;
+    nearest->radius = std::max(nearest->radius, blast.radius) + 0.5f * nearestDistance;
+    if (blast.damage > nearest->damage) {
+        nearest->type = blast.type;
+    }
+    nearest->impulse += blast.impulse;
+    nearest->damage += blast.damage;
+}
+
+// Sets off the pending blasts, blasts caused by them are set off on the next step
+void BlastEngine::step(b2World& world) {
+    if (pendingCount_ == 0) {
+        return;
+    }
+    TRACE_ZONE("BlastEngine::step");
+    size_t activeCount = pendingCount_;
+    std::copy(pending_.begin(), pending_.begin() + activeCount, active_.begin());
+    // Deferred blasts go off on the next step, before the blasts set off by this one
+    std::copy(deferred_.begin(), deferred_.begin() + deferredCount_, pending_.begin());
+    pendingCount_ = deferredCount_;
+    deferredCount_ = 0;
+    hits_.clear();
+    for (size_t i = 0; i < activeCount; i++) {
+        queryBlast(world, active_[i]);
+    }
+    applyHits();
+}
+
+void BlastEngine::clear() {
+    pendingCount_ = 0;
+    deferredCount_ = 0;
+    hits_.clear();
+}
+
+bool BlastEngine::hasPendingBlasts() const {
+    return pendingCount_ > 0;
+}
+
+size_t BlastEngine::getPendingCount() const {
+    return pendingCount_;
+}
+
+const Blast& BlastEngine::getPendingBlast(size_t index) const {
+    return pending_[index];
+}
+
+// Finds the bodies reached by the blast with one broadphase query and records their impulse and damage
+void BlastEngine::queryBlast(b2World& world, const Blast& blast) {
+    b2AABB bounds;
+    bounds.lowerBound = blast.center - b2Vec2(blast.radius, blast.radius);
+    bounds.upperBound = blast.center + b2Vec2(blast.radius, blast.radius);
+    query_.fixtures.clear();
+    world.QueryAABB(&query_, bounds);
+    // Objects have a single fixture, but keep one hit per body in case a body has several
+    std::sort(query_.fixtures.begin(), query_.fixtures.end(), [](const b2Fixture* a, const b2Fixture* b) {
+        return a->GetBody() < b->GetBody();
+    });
+    const b2Body* previousBody = nullptr;
+    for (b2Fixture* fixture : query_.fixtures) {
+        b2Body* body = fixture->GetBody();
+        if (body == previousBody) {
+            continue;
+        }
+        previousBody = body;
+        Object* object = reinterpret_cast<Object*>(fixture->GetUserData().pointer);
+        if (object == nullptr || object->isDestroyed()) {
+            continue;
+        }
+        // Distance to the closest point of the fixture bounds, so large walls are reached by their edges
+        const b2AABB& fixtureBounds = fixture->GetAABB(0);
+        b2Vec2 point = b2Clamp(blast.center, fixtureBounds.lowerBound, fixtureBounds.upperBound);
+        float distance = b2Distance(point, blast.center);
+        if (distance > blast.radius) {
+            continue;
+        }
+        float factor = blast.type->getFalloff(distance / std::max(blast.radius, b2_epsilon));
+        b2Vec2 bodyCenter = body->GetWorldCenter();
+        RayCastCallback rayCast;
+        if ((bodyCenter - blast.center).LengthSquared() > b2_epsilon * b2_epsilon) {
+            world.RayCast(&rayCast, blast.center, bodyCenter);
+        }
+        if (rayCast.closestBody != nullptr && rayCast.closestBody != body) {
+            factor *= blast.type->occludedFactor;
+        }
+        if (factor <= 0) {
+            continue;
+        }
+        b2Vec2 direction = bodyCenter - blast.center;
+        if (direction.Normalize() < b2_epsilon) {
+            direction = b2Vec2(0, 1);
+        }
+        hits_.push_back({body, object, point, blast.impulse * factor * direction, blast.damage * factor});
+    }
+}
+
+// Applies all hits of the step at once, objects destroyed by them set off their own blasts on the next step
+void BlastEngine::applyHits() {
+    for (const Hit& hit : hits_) {
+        if (hit.body->GetType() == b2_dynamicBody) {
+            hit.body->ApplyLinearImpulse(hit.impulse, hit.point, true);
+        }
+        if (hit.object->applyDamage(hit.damage)) {
+            if (const BlastType* type = getType(hit.object->getTypeAsChar())) {
+                addBlast(hit.body->GetPosition(), *type);
+            }
+        }
+    }
+    hits_.clear();
+}
+
+bool BlastEngine::QueryCallback::ReportFixture(b2Fixture* fixture) {
+    if (!fixture->IsSensor()) {
+        fixtures.push_back(fixture);
+    }
+    return true;
+}
+
+// Keeps the closest fixture along the ray, returning the fraction clips the ray to it
+float BlastEngine::RayCastCallback::ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) {
+    if (fixture->IsSensor()) {
+        return -1;
+    }
+    closestBody = fixture->GetBody();
+    return fraction;
+}
@@ -0,0 +1,109 @@
+#ifndef BLAST_HPP
+#define BLAST_HPP
+
+#include <box2d/box2d.h>
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include "object.hpp"
+
+const int BLAST_CAPACITY = 64; // Pending blasts per tick, further blasts are merged into an overlapping pending blast or deferred
+const int BLAST_HIT_CAPACITY = 1024; // Initial capacity of the query and hit buffers
+
+/**
+ * @brief Point of a blast falloff curve, the factor is interpolated linearly between the points
+ *
+ * @param distance Distance from the blast center relative to the blast radius, from 0 to 1
+ * @param factor Fraction of the impulse and damage applied at the distance
+ */
+struct FalloffPoint {
+    float distance;
+    float factor;
+};
+
+/**
+ * @brief Blast of an object type, read from assets/data/blasts.json
+ *
+ * @param radius Radius of the blast in Box2D units
+ * @param impulse Impulse applied at the blast center
+ * @param damage Damage applied at the blast center
+ * @param occludedFactor Fraction of the impulse and damage applied to bodies hidden behind other bodies
+ * @param falloff Falloff curve of the impulse and damage over the radius
+ */
+struct BlastType {
+    float radius = 0;
+    float impulse = 0;
+    float damage = 0;
+    float occludedFactor = 0;
+    std::vector<FalloffPoint> falloff;
+    float getFalloff(float distance) const;
+};
+
+/**
+ * @brief Blast waiting for the next tick, nearby blasts are merged into one
+ *
+ * @param center Center of the blast in Box2D coordinates
+ * @param radius Radius of the blast, grows when blasts are merged
+ * @param impulse Impulse at the center, the sum of the merged blasts
+ * @param damage Damage at the center, the sum of the merged blasts
+ * @param type Type of the strongest merged blast, its falloff and occlusion are used
+ */
+struct Blast {
+    b2Vec2 center;
+    float radius;
+    float impulse;
+    float damage;
+    const BlastType* type;
+};
+
+/**
+ * @brief Applies radial impulses and damage of blasts, e.g. of the explosive bird, on the physics thread
+ *
+ * Each blast finds its bodies with one b2World::QueryAABB, filters them by the distance to their fixture bounds
+ * and checks with b2World::RayCast whether other bodies block the blast. The impulses and damage of all blasts of a tick
+ * are applied in one pass afterwards. Objects destroyed by a blast set off the blast of their type on the next tick,
+ * so chain reactions spread tick by tick and blasts close to each other are merged into one query.
+ */
+class BlastEngine {
+    public:
+        BlastEngine();
+        const BlastType* getType(char objectType) const;
+        void addBlast(const b2Vec2& center, const BlastType& type);
+        void step(b2World& world);
+        void clear();
+        bool hasPendingBlasts() const;
+        size_t getPendingCount() const;
+        const Blast& getPendingBlast(size_t index) const;
+    private:
+        struct Hit {
+            b2Body* body;
+            Object* object;
+            b2Vec2 point;
+            b2Vec2 impulse;
+            float damage;
+        };
+        class QueryCallback : public b2QueryCallback {
+            public:
+                std::vector<b2Fixture*> fixtures;
+                bool ReportFixture(b2Fixture* fixture) override;
+        };
+        class RayCastCallback : public b2RayCastCallback {
+            public:
+                const b2Body* closestBody = nullptr;
+                float ReportFixture(b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float fraction) override;
+        };
+        std::unordered_map<char, BlastType> types_;
+        float mergeDistance_ = 0;
+        std::array<Blast, BLAST_CAPACITY> pending_;
+        std::array<Blast, BLAST_CAPACITY> active_;
+        std::array<Blast, BLAST_CAPACITY> deferred_; // Blasts that didn't fit in a full queue, pending on the next step
+        size_t pendingCount_ = 0;
+        size_t deferredCount_ = 0;
+        QueryCallback query_;
+        std::vector<Hit> hits_;
+        void loadTypes();
+        void queryBlast(b2World& world, const Blast& blast);
+        void applyHits();
+};
+
+#endif // BLAST_HPP
@@ -0,0 +1,156 @@
+#include "body_lod.hpp"
+#include "utils.hpp"
+#include "trace.hpp"
+#include <algorithm>
+
+// Tracks the dynamic objects of a newly loaded level, static ones like the ground never change
+void BodyLodManager::track(const std::list<Object*>& objects) {
+    entries_.clear();
+    for (auto object : objects) {
+        if (object->getBody()->GetType() == b2_dynamicBody) {
+            entries_.push_back({object, 0.f, Level::Active});
+        }
+    }
+    candidates_.reserve(entries_.size());
+    frozenCount_ = 0;
+}
+
+// Tracks an object created after the level was loaded, e.g. from a level chunk
+void BodyLodManager::add(Object* object) {
+    if (object->getBody()->GetType() == b2_dynamicBody) {
+        entries_.push_back({object, 0.f, Level::Active});
+        candidates_.reserve(entries_.size());
+    }
+}
+
+// Degrades bodies that stay settled far from the focus and wakes frozen bodies that are needed again, focus may be nullptr
+void BodyLodManager::update(const b2Vec2* focus, float deltaTime) {
+    TRACE_ZONE("BodyLodManager::update");
+    int awakeCount = 0;
+    for (auto& entry : entries_) {
+        // Removed objects and objects of disabled chunks aren't simulated
+        if (entry.object->isRemoved() && entry.level == Level::Frozen) {
+            entry.level = Level::Active;
+            frozenCount_--;
+        }
+        if (entry.object->isRemoved() || !entry.object->getBody()->IsEnabled()) {
+            continue;
+        }
+        b2Body* body = entry.object->getBody();
+        bool isFar = focus == nullptr || b2DistanceSquared(body->GetPosition(), *focus) > LOD_FAR_DISTANCE * LOD_FAR_DISTANCE;
+        if (entry.level == Level::Frozen) {
+            // Box2D wakes the body when a contact begins touching it or its island wakes up
+            bool isNear = focus != nullptr && b2DistanceSquared(body->GetPosition(), *focus) < LOD_WAKE_DISTANCE * LOD_WAKE_DISTANCE;
+            if (isNear || body->IsAwake()) {
+                thaw(entry);
+                awakeCount++;
+            }
+            continue;
+        }
+        if (utils::isBodyMoving(body)) {
+            entry.settledTime = 0;
+            entry.level = Level::Active;
+        } else {
+            entry.settledTime += deltaTime;
+        }
+        if (isFar && entry.settledTime >= LOD_FREEZE_TIME) {
+            freeze(entry);
+            continue;
+        }
+        if (isFar && entry.settledTime >= LOD_SLEEP_TIME && body->IsAwake()) {
+            body->SetAwake(false);
+            entry.level = Level::Sleeping;
+        }
+        if (body->IsAwake()) {
+            awakeCount++;
+        }
+    }
+    if (awakeCount > LOD_ACTIVE_BODY_CAP) {
+        enforceCap(focus);
+    }
+}
+
+// Wakes frozen bodies within radius of center, e.g. before a blast reaches them
+void BodyLodManager::wake(const b2Vec2& center, float radius) {
+    for (auto& entry : entries_) {
+        if (entry.level != Level::Frozen || entry.object->isRemoved()) {
+            continue;
+        }
+        if (b2DistanceSquared(entry.object->getBody()->GetPosition(), center) < radius * radius) {
+            thaw(entry);
+        }
+    }
+}
+
+// Wakes the bodies touching body, called before body is taken out of the world. Box2D doesn't wake sleeping bodies
+// when their contacts are destroyed, so they would keep floating without their support. Their stacks wake through their islands
+// and frozen ones are thawed on the next update
+void BodyLodManager::wakeTouching(b2Body* body) {
+    for (b2ContactEdge* edge = body->GetContactList(); edge != nullptr; edge = edge->next) {
+        if (edge->other->GetType() == b2_dynamicBody) {
+            edge->other->SetAwake(true);
+        }
+    }
+}
+
+// Thaws every tracked body, e.g. before restoring a saved state
+void BodyLodManager::reset() {
+    for (auto& entry : entries_) {
+        if (entry.level == Level::Frozen) {
+            thaw(entry);
+        }
+        entry.level = Level::Active;
+        entry.settledTime = 0;
+    }
+}
+
+// Forgets the tracked objects, called when the level is cleared
+void BodyLodManager::clear() {
+    entries_.clear();
+    candidates_.clear();
+    frozenCount_ = 0;
+}
+
+int BodyLodManager::getFrozenCount() const {
+    return frozenCount_;
+}
+
+void BodyLodManager::freeze(Entry& entry) {
+    entry.object->getBody()->SetAwake(false);
+    entry.level = Level::Frozen;
+    frozenCount_++;
+}
+
+void BodyLodManager::thaw(Entry& entry) {
+    entry.object->getBody()->SetAwake(true);
+    entry.level = Level::Active;
+    entry.settledTime = 0;
+    frozenCount_--;
+}
+
+// Puts the lowest priority awake bodies to sleep until the cap is met, slow bodies far from the focus go first
+void BodyLodManager::enforceCap(const b2Vec2* focus) {
+    candidates_.clear();
+    for (size_t i = 0; i < entries_.size(); i++) {
+        const Entry& entry = entries_[i];
+        const b2Body* body = entry.object->getBody();
+        if (entry.object->isRemoved() || entry.level == Level::Frozen || !body->IsEnabled() || !body->IsAwake()) {
+            continue;
+        }
+        float distance = focus != nullptr ? b2Distance(body->GetPosition(), *focus) : 0.f;
+        float speed = body->GetLinearVelocity().Length();
+        candidates_.push_back({i, speed - distance});
+    }
+    if (candidates_.size() <= LOD_ACTIVE_BODY_CAP) {
+        return;
+    }
+    size_t excess = candidates_.size() - LOD_ACTIVE_BODY_CAP;
+    std::nth_element(candidates_.begin(), candidates_.begin() + excess, candidates_.end(), [](const Candidate& a, const Candidate& b) {
+        return a.priority < b.priority;
+    });
+    for (size_t i = 0; i < excess; i++) {
+        Entry& entry = entries_[candidates_[i].index];
+        entry.object->getBody()->SetAwake(false);
+        entry.level = Level::Sleeping;
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef BODY_LOD_HPP
+#define BODY_LOD_HPP
+
+#include <box2d/box2d.h>
+#include <list>
+#include <vector>
+#include "object.hpp"
+
+const int LOD_ACTIVE_BODY_CAP = 150; // Awake level objects simulated at once, the lowest priority ones are put to sleep above it
+const float LOD_FAR_DISTANCE = 6.f; // Box2D units from the focus, e.g. the flying bird, beyond which settled bodies are degraded
+const float LOD_WAKE_DISTANCE = 4.f; // Frozen bodies closer than this to the focus are simulated again
+const float LOD_SLEEP_TIME = 1.f; // Seconds a far body has to be settled before it is put to sleep
+const float LOD_FREEZE_TIME = 3.f; // Seconds a far body has to be settled before it is frozen
+
+/**
+ * @brief Physics level of detail of the level objects, keeps the cost of World::step bounded on large levels
+ *
+ * Bodies that have settled far from the focus are first put to sleep and later frozen. Frozen bodies stay dynamic and asleep,
+ * so Box2D doesn't solve them, but an impact is still solved against a movable body. Box2D wakes a frozen body when
+ * something starts touching it and wakes the rest of its stack through the island, the next update thaws them.
+ * Frozen bodies are also thawed when the focus comes close, a body they touch is removed or a blast is about to reach them.
+ * When more than LOD_ACTIVE_BODY_CAP objects are awake, the slowest ones farthest from the focus are put to sleep first.
+ * Used by the physics thread.
+ */
+class BodyLodManager {
+    public:
+        enum class Level {
+            Active,
+            Sleeping, // Put to sleep, Box2D wakes it on contact
+            Frozen // Asleep and only checked for waking until thawed
+        };
+        void track(const std::list<Object*>& objects);
+        void add(Object* object);
+        void update(const b2Vec2* focus, float deltaTime);
+        void wake(const b2Vec2& center, float radius);
+        void wakeTouching(b2Body* body);
+        void reset();
+        void clear();
+        int getFrozenCount() const;
+    private:
+        struct Entry {
+            Object* object;
+            float settledTime;
+            Level level;
+        };
+        struct Candidate {
+            size_t index;
+            float priority; // Higher priority bodies stay awake longer
+        };
+        std::vector<Entry> entries_;
+        std::vector<Candidate> candidates_;
+        int frozenCount_ = 0;
+        void freeze(Entry& entry);
+        void thaw(Entry& entry);
+        void enforceCap(const b2Vec2* focus);
+};
+
+#endif // BODY_LOD_HPP
@@ -1,18 +1,14 @@
 #include "cannon.hpp"
-#include <iomanip>
-#include <sstream>
 
 Cannon::Cannon() {
     ResourceManager& resourceManager = ResourceManager::getInstance();
     cannon_.init();
 
-    powerText_.setFont(resourceManager.getFont("/assets/fonts/BerkshireSwash-Regular.ttf"));
-    powerText_.setString("Power: 0 %");   
+    powerText_.setFont(resourceManager.getFont("/assets/fonts/BerkshireSwash-Regular.ttf"), 40);
+    powerText_.setText("Power: 0 %");
     powerText_.setFillColor(sf::Color::White);
-    powerText_.setCharacterSize(40);
     powerText_.setPosition(20, 10);
-    powerText_.setOutlineColor(sf::Color::Black);
-    powerText_.setOutlineThickness(2);
+    powerText_.setOutline(sf::Color::Black, 2);
 
     launchSound_.setBuffer(resourceManager.getSoundBuffer("/assets/sounds/cannon_fire.ogg"));
     launchSound_.setVolume(50);
@@ -23,8 +19,11 @@ void Cannon::handleResize() {
     cannon_.handleResize();
 }
 
-void Cannon::draw(sf::RenderWindow &window) const {
-    window.draw(powerText_);
+void Cannon::draw(RenderQueue& window) const {
+    powerText_.draw(window);
+    if (isLaunching_) {
+        trajectory_.draw(window);
+    }
     cannon_.draw(window);
 }
 
@@ -35,10 +34,7 @@ void Cannon::setAngle(float angle) {
 void Cannon::setPower(float duration) {
     power_ = std::min(4 * duration, 4.f);
     auto power_ratio= power_  * 100 / 4;
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2) << power_ratio;
-    std::string power_ratio_str = oss.str();
-    powerText_.setString("Power: " + power_ratio_str + " %");
+    powerText_.format("Power: %.2f %%", power_ratio);
 }
 
 void Cannon::startLaunch() {
@@ -46,19 +42,15 @@ void Cannon::startLaunch() {
     isLaunching_ = true;
 }
 
-void Cannon::launchBird(Bird* bird) {
-    isLaunching_ = false;
-    if (bird == nullptr || bird->isLaunched()) {
-        return;
-    }
+// The bird itself is launched by World::launchBird on the physics thread
+void Cannon::launch() {
+    stopLaunch();
     launchSound_.play();
-    // Activate bird's body in b2World
-    bird->getBody()->SetEnabled(true);
-    float direction = -cannon_.barrelSprite.getRotation();
-    float x = cos(utils::DegreesToRadians(direction)) * power_;
-    float y = sin(utils::DegreesToRadians(direction)) * power_;
-    bird->getBody()->ApplyLinearImpulseToCenter(b2Vec2(x, y), true);
-    bird->setLaunched(true);
+}
+
+void Cannon::stopLaunch() {
+    isLaunching_ = false;
+    trajectory_.clear();
 }
 
 void Cannon::update() {
@@ -68,6 +60,18 @@ void Cannon::update() {
     }
 }
 
+float Cannon::getDirection() const {
+    return -cannon_.barrelSprite.getRotation();
+}
+
+float Cannon::getPower() const {
+    return power_;
+}
+
+void Cannon::setTrajectory(const TrajectoryPath& path) {
+    trajectory_.setPath(path);
+}
+
 bool Cannon::isLaunching() const {
     return isLaunching_;
 }
@@ -75,7 +79,8 @@ bool Cannon::isLaunching() const {
 void Cannon::reset() {
     power_ = 0;
     isLaunching_ = false;
-    powerText_.setString("Power: 0 %");
+    trajectory_.clear();
+    powerText_.setText("Power: 0 %");
 }
 
 void Cannon::updateTextPosition(const sf::RenderWindow& window) {
@@ -6,6 +6,8 @@
 #include "bird.hpp"
 #include "utils.hpp"
 #include "resource_manager.hpp"
+#include "trajectory.hpp"
+#include "hud_text.hpp"
 
 struct CannonSprites {
     void init() {
@@ -24,7 +26,7 @@ struct CannonSprites {
         wheelsSprite.setPosition(utils::B2ToSfCoords(b2Vec2(BIRD_INITIAL_POSITION.x, BIRD_INITIAL_POSITION.y - 0.2f)));
     }
 
-    void draw(sf::RenderWindow &window) const {
+    void draw(RenderQueue& window) const {
         window.draw(barrelSprite);
         window.draw(wheelsSprite);
     }
@@ -44,11 +46,15 @@ class Cannon {
     public:
         Cannon();
         void setAngle(float angle);
-        void draw(sf::RenderWindow &window) const;
+        void draw(RenderQueue& window) const;
         void setPower(float duration);
-        void launchBird(Bird* bird);
+        void launch();
+        void stopLaunch();
         void startLaunch();
         void update();
+        float getDirection() const;
+        float getPower() const;
+        void setTrajectory(const TrajectoryPath& path);
         bool isLaunching() const;
         void reset();
         void updateTextPosition(const sf::RenderWindow& window);
@@ -57,7 +63,8 @@ class Cannon {
         void handleMouseMove(const sf::Vector2f& mousePosition);
     private:
         CannonSprites cannon_;
-        sf::Text powerText_;
+        TrajectoryPreview trajectory_;
+        HudText powerText_;
         sf::Sound launchSound_;
         sf::Clock pressClock_;
         float power_ = 0;
@@ -0,0 +1,201 @@
+#include "chunk_streamer.hpp"
+#include "utils.hpp"
+#include "trace.hpp"
+#include <algorithm>
+#include <cmath>
+
+ChunkStreamer::ChunkStreamer() {
+    thread_ = std::thread(&ChunkStreamer::run, this);
+}
+
+ChunkStreamer::~ChunkStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isQuitting_ = true;
+    }
+    condition_.notify_all();
+    thread_.join();
+}
+
+// Called by the main thread when a level is loaded, the chunks are read once they come into range
+void ChunkStreamer::setIndex(const ChunkIndex& index) {
+    clear();
+    width_ = index.width;
+    for (const auto& info : index.chunks) {
+        auto chunk = std::make_unique<Chunk>();
+        chunk->info = info;
+        pendingPigCount_ += info.pigCount;
+        chunks_.push_back(std::move(chunk));
+    }
+}
+
+// Forgets the chunks of the previous level, the World deletes their objects
+void ChunkStreamer::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_.clear();
+    generation_++;
+    error_ = nullptr;
+    hasError_ = false;
+    chunks_.clear();
+    width_ = 0;
+    pendingPigCount_ = 0;
+    activeCount_ = 0;
+}
+
+// Requests the chunks around the camera and the bird, positions are x coordinates in Box2D units
+void ChunkStreamer::update(float cameraX, float birdX) {
+    if (chunks_.empty()) {
+        return;
+    }
+    cameraChunk_ = getChunkAt(cameraX);
+    birdChunk_ = getChunkAt(birdX);
+    for (size_t i = 0; i < chunks_.size(); i++) {
+        if (isInRange(i, CHUNK_ACTIVE_RANGE + CHUNK_LOAD_AHEAD) && chunks_[i]->state.load() == State::Unloaded) {
+            request(i);
+        }
+    }
+}
+
+// Blocks until the requested chunks are parsed, used when a level is loaded so the chunks in view are part of its start
+void ChunkStreamer::waitForLoads() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return requests_.empty() && !isLoading_; });
+    }
+    rethrowError();
+}
+
+// Throws the error of a chunk file that failed to load, called by the main thread
+void ChunkStreamer::rethrowError() {
+    if (!hasError_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::swap(error, error_);
+        hasError_ = false;
+    }
+    std::rethrow_exception(error);
+}
+
+bool ChunkStreamer::hasChunks() const {
+    return !chunks_.empty();
+}
+
+size_t ChunkStreamer::getCount() const {
+    return chunks_.size();
+}
+
+// Whether chunk i is at most range chunks away from the chunk of the camera or the bird
+bool ChunkStreamer::isInRange(size_t i, int range) const {
+    int index = static_cast<int>(i);
+    return std::abs(index - cameraChunk_) <= range || std::abs(index - birdChunk_) <= range;
+}
+
+bool ChunkStreamer::isCreated(size_t i) const {
+    return chunks_[i]->state.load() == State::Created;
+}
+
+// Moves the parsed objects of chunk i out once the loader thread is done with it, returns false while it is still loading
+bool ChunkStreamer::takeObjects(size_t i, std::vector<ChunkObject>& objects) {
+    Chunk& chunk = *chunks_[i];
+    if (chunk.state.load(std::memory_order_acquire) != State::Loaded) {
+        return false;
+    }
+    objects.swap(chunk.data);
+    chunk.data.clear();
+    chunk.data.shrink_to_fit();
+    chunk.state.store(State::Created);
+    pendingPigCount_ -= chunk.info.pigCount;
+    return true;
+}
+
+std::vector<Object*>& ChunkStreamer::getObjects(size_t i) {
+    return chunks_[i]->objects;
+}
+
+// Enables or disables the bodies of a created chunk, removed objects stay disabled
+void ChunkStreamer::setActive(size_t i, bool isActive) {
+    Chunk& chunk = *chunks_[i];
+    if (chunk.isActive == isActive || chunk.state.load() != State::Created) {
+        return;
+    }
+    for (auto object : chunk.objects) {
+        if (!object->isRemoved()) {
+            object->getBody()->SetEnabled(isActive);
+        }
+    }
+    chunk.isActive = isActive;
+    activeCount_ += isActive ? 1 : -1;
+}
+
+// Disables every created chunk, e.g. after restoring a saved state, the chunks in range are enabled again by the World
+void ChunkStreamer::deactivateAll() {
+    for (auto& chunk : chunks_) {
+        for (auto object : chunk->objects) {
+            if (!object->isRemoved()) {
+                object->getBody()->SetEnabled(false);
+            }
+        }
+        chunk->isActive = false;
+    }
+    activeCount_ = 0;
+}
+
+int ChunkStreamer::getPendingPigCount() const {
+    return pendingPigCount_;
+}
+
+int ChunkStreamer::getActiveCount() const {
+    return activeCount_;
+}
+
+int ChunkStreamer::getChunkAt(float x) const {
+    int index = static_cast<int>(std::floor(x / width_));
+    return std::min(std::max(index, 0), static_cast<int>(chunks_.size()) - 1);
+}
+
+void ChunkStreamer::request(size_t i) {
+    chunks_[i]->state.store(State::Loading);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requests_.push_back({i, utils::getExecutablePath() + "/assets/levels/" + chunks_[i]->info.file, generation_});
+    }
+    condition_.notify_all();
+}
+
+// Loader thread, parses the requested chunk files in order
+void ChunkStreamer::run() {
+    trace::setThreadName("ChunkLoader");
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this] { return !requests_.empty() || isQuitting_; });
+        if (isQuitting_) {
+            return;
+        }
+        Request request = requests_.front();
+        requests_.pop_front();
+        isLoading_ = true;
+        lock.unlock();
+        std::vector<ChunkObject> objects;
+        std::exception_ptr error;
+        try {
+            objects = LevelLoader::readChunkFile(request.path);
+        } catch (const std::exception&) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        if (error && request.generation == generation_ && !error_) {
+            error_ = error;
+            hasError_.store(true, std::memory_order_release);
+        }
+        if (request.generation == generation_) {
+            Chunk& chunk = *chunks_[request.index];
+            chunk.data = std::move(objects);
+            chunk.state.store(State::Loaded, std::memory_order_release);
+        }
+        isLoading_ = false;
+        condition_.notify_all();
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef CHUNK_STREAMER_HPP
+#define CHUNK_STREAMER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "level_loader.hpp"
+
+const int CHUNK_ACTIVE_RANGE = 1; // Chunks on each side of the camera and the flying bird whose bodies are simulated and drawn
+const int CHUNK_LOAD_AHEAD = 2; // Chunks beyond the active ones whose files are read in the background
+
+/**
+ * @brief Streams the chunks of levels wider than WORLD_WIDTH
+ *
+ * Chunk files are read and parsed on a loader thread before the camera or the flying bird reaches them, chunks that are
+ * never reached are never read. The World creates the objects of a chunk once it comes within CHUNK_ACTIVE_RANGE chunks
+ * of the camera or the bird and the streamer disables their bodies again when the chunk falls behind, so far parts of the
+ * level are neither simulated nor drawn. Objects of chunks that fall behind stay in memory with their bodies disabled,
+ * so the damage and positions of a chunk the camera returns to are kept.
+ * A chunk file that fails to load is reported on the main thread like a broken level file.
+ * Used by the physics thread while a level runs and by the main thread while it is paused.
+ */
+class ChunkStreamer {
+    public:
+        ChunkStreamer();
+        ~ChunkStreamer();
+        ChunkStreamer(const ChunkStreamer&) = delete;
+        ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+        void setIndex(const ChunkIndex& index);
+        void clear();
+        void update(float cameraX, float birdX);
+        void waitForLoads();
+        void rethrowError();
+        bool hasChunks() const;
+        size_t getCount() const;
+        bool isInRange(size_t i, int range) const;
+        bool isCreated(size_t i) const;
+        bool takeObjects(size_t i, std::vector<ChunkObject>& objects);
+        std::vector<Object*>& getObjects(size_t i);
+        void setActive(size_t i, bool isActive);
+        void deactivateAll();
+        int getPendingPigCount() const;
+        int getActiveCount() const;
+    private:
+        enum class State {
+            Unloaded,
+            Loading, // Requested from the loader thread
+            Loaded, // Parsed, objects not created yet
+            Created
+        };
+        struct Chunk {
+            ChunkInfo info;
+            std::atomic<State> state{State::Unloaded};
+            std::vector<ChunkObject> data; // Written by the loader thread before the state becomes Loaded
+            std::vector<Object*> objects; // Created objects, owned by the World
+            bool isActive = false;
+        };
+        struct Request {
+            size_t index;
+            std::string path;
+            unsigned int generation;
+        };
+        std::vector<std::unique_ptr<Chunk>> chunks_;
+        float width_ = 0;
+        int cameraChunk_ = 0;
+        int birdChunk_ = 0;
+        int pendingPigCount_ = 0;
+        int activeCount_ = 0;
+        std::mutex mutex_; // Guards the requests and the parsed data handed over by the loader thread
+        std::condition_variable condition_;
+        std::deque<Request> requests_;
+        unsigned int generation_ = 0; // Incremented when the chunks are cleared, results of older requests are dropped
+        bool isLoading_ = false;
+        std::exception_ptr error_; // First chunk file that failed to load, rethrown on the main thread
+        std::atomic<bool> hasError_{false};
+        bool isQuitting_ = false;
+        std::thread thread_;
+        int getChunkAt(float x) const;
+        void request(size_t i);
+        void run();
+};
+
+#endif // CHUNK_STREAMER_HPP
@@ -0,0 +1,60 @@
+#ifndef COLLISION_FILTER_HPP
+#define COLLISION_FILTER_HPP
+
+#include <box2d/box2d.h>
+#include <array>
+#include <cstdint>
+#include "damage_table.hpp"
+
+/**
+ * @brief Pair of object types whose fixtures never collide, Box2D rejects them in the broadphase before creating a contact
+ *
+ * Only pairs that have no gameplay effect and don't need to push each other belong here. E.g. walls take no damage from
+ * the ground but still have to rest on it.
+ */
+struct CollisionExclusion {
+    Object::Type a;
+    Object::Type b;
+};
+
+constexpr std::array<CollisionExclusion, 2> COLLISION_EXCLUSIONS = {{
+    {Object::Type::MiniBird, Object::Type::Bird}, // MiniBirds spawn next to their bird and neither damages the other
+    {Object::Type::MiniBird, Object::Type::MiniBird}
+}};
+
+constexpr uint16_t getCategoryBits(Object::Type type) {
+    return static_cast<uint16_t>(1u << getTypeIndex(type));
+}
+
+/**
+ * @brief Category and mask bits of an object type, b2Filter itself can't be built at compile time
+ */
+struct CollisionBits {
+    uint16_t category;
+    uint16_t mask;
+};
+
+// Bits of each object type, built from the exclusions so both sides of a pair always agree
+constexpr std::array<CollisionBits, OBJECT_TYPE_COUNT> makeCollisionBits() {
+    std::array<CollisionBits, OBJECT_TYPE_COUNT> bits{};
+    for (size_t i = 0; i < OBJECT_TYPE_COUNT; i++) {
+        bits[i] = {static_cast<uint16_t>(1u << i), 0xFFFF};
+    }
+    for (const auto& exclusion : COLLISION_EXCLUSIONS) {
+        bits[getTypeIndex(exclusion.a)].mask &= static_cast<uint16_t>(~getCategoryBits(exclusion.b));
+        bits[getTypeIndex(exclusion.b)].mask &= static_cast<uint16_t>(~getCategoryBits(exclusion.a));
+    }
+    return bits;
+}
+
+constexpr std::array<CollisionBits, OBJECT_TYPE_COUNT> COLLISION_BITS = makeCollisionBits();
+
+// Filter for the fixtures of an object type
+inline b2Filter getCollisionFilter(Object::Type type) {
+    b2Filter filter;
+    filter.categoryBits = COLLISION_BITS[getTypeIndex(type)].category;
+    filter.maskBits = COLLISION_BITS[getTypeIndex(type)].mask;
+    return filter;
+}
+
+#endif // COLLISION_FILTER_HPP
@@ -0,0 +1,97 @@
+#include "damage_table.hpp"
+#include "utils.hpp"
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+DamageTable::DamageTable() {
+    load(utils::getExecutablePath() + "/assets/data/damage.json");
+}
+
+DamageTable& DamageTable::getInstance() {
+    static DamageTable instance;
+    return instance;
+}
+
+// Rules of the file replace the default rule of their pair, fields left out keep the default values
+void DamageTable::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return; // The built-in table is used
+    }
+    json damageJson;
+    file >> damageJson;
+    file.close();
+    auto getType = [](const std::string& name) {
+        if (name == "Bird") {
+            return Object::Type::Bird;
+        } else if (name == "Pig") {
+            return Object::Type::Pig;
+        } else if (name == "Ground") {
+            return Object::Type::Ground;
+        } else if (name == "Wall") {
+            return Object::Type::Wall;
+        } else if (name == "MiniBird") {
+            return Object::Type::MiniBird;
+        }
+        throw std::runtime_error("Invalid object type " + name + " in damage table. Should be one of Bird, Pig, Ground, Wall, MiniBird");
+    };
+    fallHeight_ = damageJson.value("fallHeight", DEFAULT_FALL_HEIGHT);
+    for (const auto& [targetName, sources] : damageJson.at("rules").items()) {
+        Object::Type target = getType(targetName);
+        for (const auto& [sourceName, ruleJson] : sources.items()) {
+            DamageRule& rule = matrix_[getTypeIndex(target)][getTypeIndex(getType(sourceName))];
+            rule.multiplier = ruleJson.value("multiplier", rule.multiplier);
+            rule.threshold = ruleJson.value("threshold", rule.threshold);
+            rule.isImmune = ruleJson.value("immune", false);
+            rule.isSelfScaled = ruleJson.value("selfScaled", rule.isSelfScaled);
+            std::string impact = ruleJson.value("impact", std::string());
+            if (impact == "speedSquared") {
+                rule.impact = ImpactMeasure::SourceSpeedSquared;
+            } else if (impact == "fallSpeedSquared") {
+                rule.impact = ImpactMeasure::FallSpeedSquared;
+            } else if (impact == "fallSpeed") {
+                rule.impact = ImpactMeasure::FallSpeed;
+            } else if (!impact.empty()) {
+                throw std::runtime_error("Invalid impact " + impact + " in damage table. Should be one of speedSquared, fallSpeedSquared, fallSpeed");
+            }
+        }
+    }
+}
+
+const DamageRule& DamageTable::getRule(Object::Type target, Object::Type source) const {
+    return matrix_[getTypeIndex(target)][getTypeIndex(source)];
+}
+
+// Damage the target takes from a contact with the source before damage multipliers, 0 for ignored impacts
+float DamageTable::getDamage(Object::Type target, Object::Type source, const b2Body* targetBody, const b2Body* sourceBody, float targetPrevY) const {
+    const DamageRule& rule = getRule(target, source);
+    if (rule.isImmune) {
+        return 0;
+    }
+    float impact = 0;
+    switch (rule.impact) {
+        case ImpactMeasure::SourceSpeedSquared:
+            impact = sourceBody->GetLinearVelocity().LengthSquared();
+            break;
+        case ImpactMeasure::FallSpeedSquared:
+            impact = targetPrevY > fallHeight_ ? targetBody->GetLinearVelocity().LengthSquared() : 0;
+            break;
+        case ImpactMeasure::FallSpeed:
+            impact = targetPrevY > fallHeight_ ? targetBody->GetLinearVelocity().Length() : 0;
+            break;
+    }
+    float damage = impact * rule.multiplier;
+    return damage > rule.threshold ? damage : 0;
+}
+
+// Damages the target of one side of a touching contact, called for both objects of the contact
+void DamageTable::applyContact(Object& target, const Object& source) const {
+    float damage = getDamage(target.getType(), source.getType(), target.getBody(), source.getBody(), target.getPrevY());
+    if (damage <= 0) {
+        return;
+    }
+    const DamageRule& rule = getRule(target.getType(), source.getType());
+    target.applyDamage(damage * (rule.isSelfScaled ? target.getDamageMultiplier() : source.getDamageMultiplier()));
+}
@@ -0,0 +1,97 @@
+#ifndef DAMAGE_TABLE_HPP
+#define DAMAGE_TABLE_HPP
+
+#include <box2d/box2d.h>
+#include <array>
+#include <string>
+#include "object.hpp"
+
+const size_t OBJECT_TYPE_COUNT = 5; // Number of Object::Type values
+const float DEFAULT_FALL_HEIGHT = 0.95f; // Objects take fall damage from the ground only if they were above this height on the previous step
+
+/**
+ * @brief How the impact of a contact is measured before the rule's multiplier
+ */
+enum class ImpactMeasure {
+    SourceSpeedSquared, // Squared speed of the object that hit the target
+    FallSpeedSquared, // Squared speed of the target itself if it fell from above the fall height, e.g. a pig landing on the ground
+    FallSpeed // Same as FallSpeedSquared without squaring
+};
+
+/**
+ * @brief Damage rule of a target type hit by a source type
+ *
+ * @param multiplier Scales the measured impact
+ * @param threshold Scaled impacts at or below the threshold are ignored
+ * @param impact How the impact is measured
+ * @param isImmune Whether the target takes no damage from the source at all
+ * @param isSelfScaled Whether the damage is scaled by the damage multiplier of the target instead of the source's
+ */
+struct DamageRule {
+    float multiplier = 1.f;
+    float threshold = 0.1f;
+    ImpactMeasure impact = ImpactMeasure::SourceSpeedSquared;
+    bool isImmune = true;
+    bool isSelfScaled = false;
+};
+
+// Rules indexed by the target type and then the source type
+using DamageMatrix = std::array<std::array<DamageRule, OBJECT_TYPE_COUNT>, OBJECT_TYPE_COUNT>;
+
+constexpr size_t getTypeIndex(Object::Type type) {
+    return static_cast<size_t>(type);
+}
+
+// Built-in balance, used when assets/data/damage.json is missing and for pairs the file doesn't list
+constexpr DamageMatrix makeDefaultDamageMatrix() {
+    using Type = Object::Type;
+    DamageMatrix matrix{}; // Every pair is immune unless set below
+    auto set = [&matrix](Type target, Type source, DamageRule rule) {
+        matrix[getTypeIndex(target)][getTypeIndex(source)] = rule;
+    };
+    // Birds take damage scaled by their own multiplier and none from MiniBirds
+    set(Type::Bird, Type::Bird, {1.f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, true});
+    set(Type::Bird, Type::Pig, {0.5f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, true});
+    set(Type::Bird, Type::Wall, {1.5f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, true});
+    set(Type::Bird, Type::Ground, {0.1f, 0.1f, ImpactMeasure::FallSpeed, false, true});
+    // MiniBirds only take damage from level objects, scaled by their own multiplier
+    set(Type::MiniBird, Type::Pig, {2.f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, true});
+    set(Type::MiniBird, Type::Wall, {2.f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, true});
+    // Pigs and walls take damage scaled by the multiplier of what hit them
+    set(Type::Pig, Type::Bird, {0.2f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, false});
+    set(Type::Pig, Type::MiniBird, {0.2f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, false});
+    set(Type::Pig, Type::Pig, {0.5f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, false});
+    set(Type::Pig, Type::Wall, {1.1f, 0.1f, ImpactMeasure::SourceSpeedSquared, false, false});
+    set(Type::Pig, Type::Ground, {0.45f, 0.1f, ImpactMeasure::FallSpeedSquared, false, false});
+    set(Type::Wall, Type::Bird, {0.25f, 0.01f, ImpactMeasure::SourceSpeedSquared, false, false});
+    set(Type::Wall, Type::MiniBird, {0.25f, 0.01f, ImpactMeasure::SourceSpeedSquared, false, false});
+    set(Type::Wall, Type::Pig, {0.2f, 0.01f, ImpactMeasure::SourceSpeedSquared, false, false});
+    set(Type::Wall, Type::Wall, {0.3f, 0.01f, ImpactMeasure::SourceSpeedSquared, false, false});
+    return matrix;
+}
+
+constexpr DamageMatrix DEFAULT_DAMAGE_MATRIX = makeDefaultDamageMatrix();
+
+/**
+ * @brief Contact damage of every pair of object types
+ *
+ * Starts from DEFAULT_DAMAGE_MATRIX and applies the rules of assets/data/damage.json on top of it, so the balance can be
+ * tuned without recompiling. Resolving a contact is a table lookup instead of virtual calls on both objects.
+ * The table is read only after it is loaded, so the physics thread and the tools can use it from several threads.
+ */
+class DamageTable {
+    public:
+        static DamageTable& getInstance();
+        DamageTable(const DamageTable&) = delete;
+        DamageTable& operator=(const DamageTable&) = delete;
+        const DamageRule& getRule(Object::Type target, Object::Type source) const;
+        float getDamage(Object::Type target, Object::Type source, const b2Body* targetBody, const b2Body* sourceBody, float targetPrevY) const;
+        void applyContact(Object& target, const Object& source) const;
+    private:
+        DamageTable();
+        DamageMatrix matrix_ = DEFAULT_DAMAGE_MATRIX;
+        float fallHeight_ = DEFAULT_FALL_HEIGHT;
+        void load(const std::string& path);
+};
+
+#endif // DAMAGE_TABLE_HPP
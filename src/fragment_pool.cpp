@@ -0,0 +1,200 @@
+#include "fragment_pool.hpp"
+#include "utils.hpp"
+#include "resource_manager.hpp"
+#include "collision_filter.hpp"
+#include <cmath>
+
+const float FRAGMENT_GAP = 0.95f; // Fragment fixtures are slightly smaller than their part of the wall, so they don't start overlapping
+const float FRAGMENT_BURST_SPEED = 1.5f; // Speed of the fragments away from the wall center
+
+FragmentPool::FragmentPool(SpscQueue<WorldEvent, 1024>& events) : events_(events) {}
+
+// Creates the disabled fragment bodies of a level, called by the main thread after loading a level
+void FragmentPool::create(b2World& world) {
+    texture_ = &ResourceManager::getInstance().getTexture(WALL_TEXTURE);
+    for (auto& fragment : fragments_) {
+        b2BodyDef bodyDef;
+        bodyDef.type = b2_dynamicBody;
+        bodyDef.enabled = false;
+        bodyDef.awake = false;
+        fragment.body = world.CreateBody(&bodyDef);
+        fragment.halfSize = b2Vec2_zero;
+        fragment.sprite.setTexture(*texture_);
+        fragment.isActive = false;
+    }
+    activeCount_ = 0;
+}
+
+// Forgets the bodies after the level has destroyed every body of the Box2D world
+void FragmentPool::release() {
+    for (auto& fragment : fragments_) {
+        fragment.body = nullptr;
+        fragment.isActive = false;
+    }
+    layouts_.clear();
+    activeCount_ = 0;
+}
+
+// Computes the pieces of walls of this size, called for each wall when a level is loaded so fracturing doesn't allocate
+void FragmentPool::cacheLayout(const Wall& wall) {
+    getLayout(wall);
+}
+
+const FractureLayout& FragmentPool::getLayout(const Wall& wall) {
+    const b2Vec2& halfSize = wall.getHalfSize();
+    auto key = getLayoutKey(halfSize);
+    auto it = layouts_.find(key);
+    if (it != layouts_.end()) {
+        return it->second;
+    }
+    FractureLayout layout;
+    // Long walls break into three pieces along their length, others into two by two
+    int columns = halfSize.x > 1.5f * halfSize.y ? 3 : 2;
+    int rows = halfSize.y > 1.5f * halfSize.x ? 3 : 2;
+    sf::Vector2u textureSize = texture_ != nullptr ? texture_->getSize() : sf::Vector2u(1, 1);
+    int pieceWidth = textureSize.x / columns;
+    int pieceHeight = textureSize.y / rows;
+    layout.count = columns * rows;
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            int i = row * columns + column;
+            layout.halfSizes[i] = b2Vec2(halfSize.x / columns * FRAGMENT_GAP, halfSize.y / rows * FRAGMENT_GAP);
+            layout.offsets[i] = b2Vec2(
+                -halfSize.x + (2 * column + 1) * halfSize.x / columns,
+                -halfSize.y + (2 * row + 1) * halfSize.y / rows
+            );
+            // Box2D y grows upwards and texture y downwards, so the bottom row shows the bottom of the texture
+            layout.textureRects[i] = sf::IntRect(column * pieceWidth, (rows - 1 - row) * pieceHeight, pieceWidth, pieceHeight);
+        }
+    }
+    return layouts_.emplace(key, layout).first->second;
+}
+
+// Replaces the wall with its pieces, moving with the wall and bursting slightly outwards
+void FragmentPool::fracture(const Wall& wall) {
+    if (texture_ == nullptr) {
+        return; // Pool not created for this level
+    }
+    const FractureLayout& layout = getLayout(wall);
+    const b2Body* wallBody = wall.getBody();
+    const b2Fixture* wallFixture = wallBody->GetFixtureList();
+    sf::Vector2f scale = wall.getSprite().getScale();
+    for (int i = 0; i < layout.count; i++) {
+        Fragment& fragment = acquire();
+        b2Body* body = fragment.body;
+        // Only recreate the fixture when the piece size changes, which uses Box2D's block allocator
+        if (fragment.halfSize.x != layout.halfSizes[i].x || fragment.halfSize.y != layout.halfSizes[i].y) {
+            if (b2Fixture* fixture = body->GetFixtureList()) {
+                body->DestroyFixture(fixture);
+            }
+            b2PolygonShape shape;
+            shape.SetAsBox(layout.halfSizes[i].x, layout.halfSizes[i].y);
+            b2FixtureDef fixtureDef;
+            fixtureDef.shape = &shape;
+            fixtureDef.filter = getCollisionFilter(Object::Type::Wall); // Fragments collide like the wall they came from
+            if (wallFixture != nullptr) {
+                fixtureDef.density = wallFixture->GetDensity();
+                fixtureDef.friction = wallFixture->GetFriction();
+                fixtureDef.restitution = wallFixture->GetRestitution();
+            }
+            body->CreateFixture(&fixtureDef);
+            fragment.halfSize = layout.halfSizes[i];
+        }
+        b2Vec2 position = wallBody->GetWorldPoint(layout.offsets[i]);
+        b2Vec2 direction = position - wallBody->GetPosition();
+        direction.Normalize();
+        body->SetEnabled(true);
+        body->SetTransform(position, wallBody->GetAngle());
+        body->SetLinearVelocity(wallBody->GetLinearVelocityFromWorldPoint(position) + FRAGMENT_BURST_SPEED * direction);
+        body->SetAngularVelocity(wallBody->GetAngularVelocity());
+        body->SetAwake(true);
+        const sf::IntRect& rect = layout.textureRects[i];
+        fragment.sprite.setTextureRect(rect);
+        fragment.sprite.setOrigin(rect.width / 2.f, rect.height / 2.f);
+        fragment.sprite.setScale(scale);
+        fragment.age = 0;
+        fragment.order = nextOrder_++;
+        fragment.isActive = true;
+        activeCount_++;
+        updateSprite(fragment);
+    }
+}
+
+// Ages the fragments and collapses the ones that have settled, left the world or lived long enough
+void FragmentPool::update(float deltaTime) {
+    for (auto& fragment : fragments_) {
+        if (!fragment.isActive) {
+            continue;
+        }
+        fragment.age += deltaTime;
+        updateSprite(fragment);
+        bool isSettled = fragment.age >= FRAGMENT_SETTLE_TIME && !utils::isBodyMoving(fragment.body);
+        if (isSettled || fragment.age >= FRAGMENT_LIFETIME || utils::isOutOfBounds(fragment.body->GetPosition())) {
+            collapse(fragment, true);
+        }
+    }
+}
+
+// Disables every fragment without effects, e.g. when a level is restarted
+void FragmentPool::clear() {
+    for (auto& fragment : fragments_) {
+        if (fragment.isActive) {
+            collapse(fragment, false);
+        }
+    }
+}
+
+void FragmentPool::captureSprites(std::vector<sf::Sprite>& sprites) const {
+    for (const auto& fragment : fragments_) {
+        if (fragment.isActive) {
+            sprites.push_back(fragment.sprite);
+        }
+    }
+}
+
+bool FragmentPool::isSettled() const {
+    return activeCount_ == 0;
+}
+
+int FragmentPool::getActiveCount() const {
+    return activeCount_;
+}
+
+// Free fragment, or the oldest active one once the body budget is used up
+FragmentPool::Fragment& FragmentPool::acquire() {
+    Fragment* oldest = nullptr;
+    for (auto& fragment : fragments_) {
+        if (!fragment.isActive) {
+            return fragment;
+        }
+        if (oldest == nullptr || fragment.order < oldest->order) {
+            oldest = &fragment;
+        }
+    }
+    collapse(*oldest, true);
+    return *oldest;
+}
+
+// Takes the fragment out of the simulation, the main thread replaces it with particles
+void FragmentPool::collapse(Fragment& fragment, bool hasEffects) {
+    if (hasEffects) {
+        WorldEvent event;
+        event.type = 'F';
+        event.position = fragment.sprite.getPosition();
+        sf::FloatRect bounds = fragment.sprite.getGlobalBounds();
+        event.size = std::max(bounds.width, bounds.height);
+        events_.push(event);
+    }
+    fragment.body->SetEnabled(false);
+    fragment.isActive = false;
+    activeCount_--;
+}
+
+void FragmentPool::updateSprite(Fragment& fragment) {
+    fragment.sprite.setPosition(utils::B2ToSfCoords(fragment.body->GetPosition()));
+    fragment.sprite.setRotation(-utils::RadiansToDegrees(fragment.body->GetAngle()));
+}
+
+std::pair<int, int> FragmentPool::getLayoutKey(const b2Vec2& halfSize) {
+    return {static_cast<int>(std::lround(halfSize.x * 100.f)), static_cast<int>(std::lround(halfSize.y * 100.f))};
+}
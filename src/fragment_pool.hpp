@@ -0,0 +1,78 @@
+#ifndef FRAGMENT_POOL_HPP
+#define FRAGMENT_POOL_HPP
+
+#include <box2d/box2d.h>
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <map>
+#include <utility>
+#include <vector>
+#include "wall.hpp"
+#include "spsc_queue.hpp"
+#include "world_snapshot.hpp"
+
+const int FRAGMENT_BODY_BUDGET = 48; // Fragment bodies simulated at once, the oldest fragment collapses when a new one needs a body
+const int FRAGMENTS_PER_WALL = 6;
+const float FRAGMENT_LIFETIME = 3.f; // Seconds before a fragment collapses into particles
+const float FRAGMENT_SETTLE_TIME = 0.5f; // Seconds a fragment flies at least before it can collapse by settling
+
+/**
+ * @brief Pieces a wall of one size breaks into, computed once per wall size of a level
+ *
+ * @param count Number of pieces
+ * @param halfSizes Half width and height of each piece in Box2D units
+ * @param offsets Center of each piece relative to the wall center in Box2D units
+ * @param textureRects Part of the wall texture shown by each piece
+ */
+struct FractureLayout {
+    int count = 0;
+    std::array<b2Vec2, FRAGMENTS_PER_WALL> halfSizes;
+    std::array<b2Vec2, FRAGMENTS_PER_WALL> offsets;
+    std::array<sf::IntRect, FRAGMENTS_PER_WALL> textureRects;
+};
+
+/**
+ * @brief Breaks destroyed walls into short-lived fragment bodies taken from a preallocated pool, used by the physics thread
+ *
+ * The pool creates FRAGMENT_BODY_BUDGET disabled bodies when a level is loaded, so fracturing only enables and moves them.
+ * A body's box fixture is only recreated when the fragment size changes. Fragments don't take or deal damage.
+ * They collapse into particles when they settle, leave the world or reach FRAGMENT_LIFETIME. When the budget is used up,
+ * the oldest fragments collapse early, so fracturing a large structure can't grow the cost of the step without bound.
+ */
+class FragmentPool {
+    public:
+        FragmentPool(SpscQueue<WorldEvent, 1024>& events);
+        FragmentPool(const FragmentPool&) = delete;
+        FragmentPool& operator=(const FragmentPool&) = delete;
+        void create(b2World& world);
+        void release();
+        void cacheLayout(const Wall& wall);
+        void fracture(const Wall& wall);
+        void update(float deltaTime);
+        void clear();
+        void captureSprites(std::vector<sf::Sprite>& sprites) const;
+        bool isSettled() const;
+        int getActiveCount() const;
+    private:
+        struct Fragment {
+            b2Body* body = nullptr;
+            b2Vec2 halfSize = b2Vec2_zero; // Size of the current fixture
+            sf::Sprite sprite;
+            float age = 0;
+            unsigned int order = 0; // Fracture order, the smallest active order is the oldest fragment
+            bool isActive = false;
+        };
+        SpscQueue<WorldEvent, 1024>& events_; // Collapsed fragments are sent to the main thread like removed objects
+        const sf::Texture* texture_ = nullptr;
+        std::array<Fragment, FRAGMENT_BODY_BUDGET> fragments_;
+        std::map<std::pair<int, int>, FractureLayout> layouts_; // Keyed by the wall half size in centimeters
+        unsigned int nextOrder_ = 0;
+        int activeCount_ = 0;
+        const FractureLayout& getLayout(const Wall& wall);
+        Fragment& acquire();
+        void collapse(Fragment& fragment, bool hasEffects);
+        void updateSprite(Fragment& fragment);
+        static std::pair<int, int> getLayoutKey(const b2Vec2& halfSize);
+};
+
+#endif // FRAGMENT_POOL_HPP
@@ -0,0 +1,165 @@
+#include "frame_profiler.hpp"
+#include <algorithm>
+
+namespace {
+    float getMilliseconds(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+        return std::chrono::duration<float, std::milli>(end - start).count();
+    }
+
+    // The first sample is the latest, the samples are reordered
+    template <typename Iterator>
+    PhaseStats getPercentiles(Iterator begin, int count) {
+        PhaseStats stats;
+        stats.last = *begin;
+        auto end = begin + count;
+        auto percentile = [&](float p) {
+            auto nth = begin + std::min(count - 1, static_cast<int>(p * count));
+            std::nth_element(begin, nth, end);
+            return *nth;
+        };
+        stats.p50 = percentile(0.50f);
+        stats.p95 = percentile(0.95f);
+        stats.p99 = percentile(0.99f);
+        return stats;
+    }
+}
+
+FrameProfiler::FrameProfiler() : frameStart_(std::chrono::steady_clock::now()) {}
+
+// Starts a new frame, the time since the previous call is recorded as the frame time
+void FrameProfiler::beginFrame() {
+    auto now = std::chrono::steady_clock::now();
+    float frameTime = getMilliseconds(frameStart_, now);
+    frameStart_ = now;
+    samples_[static_cast<int>(Phase::Frame)][frame_] = frameTime;
+    frame_ = (frame_ + 1) % PROFILER_HISTORY;
+    frameCount_ = std::min(frameCount_ + 1, PROFILER_HISTORY);
+    // Clear the slot of the new frame, phases that don't run this frame take 0 ms
+    for (auto& phaseSamples : samples_) {
+        phaseSamples[frame_] = 0;
+    }
+}
+
+void FrameProfiler::addSample(Phase phase, float milliseconds) {
+    samples_[static_cast<int>(phase)][frame_] += milliseconds;
+}
+
+void FrameProfiler::setPhysicsStats(const PhysicsStats& stats) {
+    physicsStats_ = stats;
+}
+
+// Counting awake bodies walks the body list, so it should only be done when the overlay is shown
+PhysicsStats FrameProfiler::capturePhysicsStats(const b2World& world, bool countAwakeBodies) {
+    PhysicsStats stats;
+    const b2Profile& profile = world.GetProfile();
+    stats.step = profile.step;
+    stats.collide = profile.collide;
+    stats.solve = profile.solve;
+    stats.broadphase = profile.broadphase;
+    stats.bodyCount = world.GetBodyCount();
+    stats.contactCount = world.GetContactCount();
+    if (!countAwakeBodies) {
+        return stats;
+    }
+    for (const b2Body* body = world.GetBodyList(); body; body = body->GetNext()) {
+        if (body->GetType() != b2_staticBody && body->IsAwake() && body->IsEnabled()) {
+            stats.awakeBodyCount++;
+        }
+    }
+    return stats;
+}
+
+// Completed frames only, framesAgo 0 is the previous frame
+float FrameProfiler::getSample(Phase phase, int framesAgo) const {
+    int index = (frame_ - 1 - framesAgo + 2 * PROFILER_HISTORY) % PROFILER_HISTORY;
+    return samples_[static_cast<int>(phase)][index];
+}
+
+PhaseStats FrameProfiler::getStats(Phase phase) const {
+    int count = frameCount_ - 1; // The current frame is still being recorded
+    if (count <= 0) {
+        return PhaseStats();
+    }
+    for (int i = 0; i < count; i++) {
+        sortBuffer_[i] = getSample(phase, i);
+    }
+    return getPercentiles(sortBuffer_.begin(), count);
+}
+
+// Time from the first input of a frame to the present of the frame, called by the render thread
+void FrameProfiler::addInputLatency(float milliseconds) {
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    latencySamples_[latencyIndex_] = milliseconds;
+    latencyIndex_ = (latencyIndex_ + 1) % INPUT_LATENCY_HISTORY;
+    latencyCount_ = std::min(latencyCount_ + 1, INPUT_LATENCY_HISTORY);
+}
+
+PhaseStats FrameProfiler::getInputLatencyStats() const {
+    int count = 0;
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex_);
+        count = latencyCount_;
+        for (int i = 0; i < count; i++) {
+            sortBuffer_[i] = latencySamples_[(latencyIndex_ - 1 - i + INPUT_LATENCY_HISTORY) % INPUT_LATENCY_HISTORY];
+        }
+    }
+    if (count == 0) {
+        return PhaseStats();
+    }
+    return getPercentiles(sortBuffer_.begin(), count);
+}
+
+const PhysicsStats& FrameProfiler::getPhysicsStats() const {
+    return physicsStats_;
+}
+
+int FrameProfiler::getFrameCount() const {
+    return std::max(0, frameCount_ - 1);
+}
+
+bool FrameProfiler::isEnabled() const {
+    return isEnabled_;
+}
+
+void FrameProfiler::toggle() {
+    isEnabled_ = !isEnabled_.load();
+}
+
+const char* FrameProfiler::getPhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::Events:
+            return "Events";
+        case Phase::Update:
+            return "Update";
+        case Phase::Step:
+            return "  Step";
+        case Phase::Collisions:
+            return "  Collisions";
+        case Phase::ObjectState:
+            return "  Object state";
+        case Phase::BirdState:
+            return "  Bird state";
+        case Phase::Camera:
+            return "Camera";
+        case Phase::HUD:
+            return "HUD";
+        case Phase::Render:
+            return "Render";
+        case Phase::Frame:
+            return "Frame";
+        default:
+            return "";
+    }
+}
+
+ScopedPhase::ScopedPhase(FrameProfiler::Phase phase) : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+ScopedPhase::~ScopedPhase() {
+    FrameProfiler::getInstance().addSample(phase_, getMilliseconds(start_, std::chrono::steady_clock::now()));
+}
+
+ScopedTimer::ScopedTimer(float& milliseconds) : milliseconds_(milliseconds), start_(std::chrono::steady_clock::now()) {}
+
+ScopedTimer::~ScopedTimer() {
+    milliseconds_ = getMilliseconds(start_, std::chrono::steady_clock::now());
+}
@@ -0,0 +1,130 @@
+#ifndef FRAME_PROFILER_HPP
+#define FRAME_PROFILER_HPP
+
+#include <box2d/box2d.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+const int PROFILER_HISTORY = 240; // Number of frames kept in the ring buffer, 4 seconds at 60 fps
+const int INPUT_LATENCY_HISTORY = 120; // Number of input latency samples kept, at most PROFILER_HISTORY
+
+/**
+ * @brief Box2D numbers of the latest step
+ *
+ * @param step, collide, solve, broadphase Milliseconds reported by b2World::GetProfile
+ * @param bodyCount Number of bodies in the world
+ * @param awakeBodyCount Number of awake dynamic bodies, Box2D solves one island per group of touching awake bodies
+ * @param contactCount Number of contacts in the world
+ * @param frozenBodyCount Number of level objects frozen by the BodyLodManager
+ */
+struct PhysicsStats {
+    float step = 0;
+    float collide = 0;
+    float solve = 0;
+    float broadphase = 0;
+    int bodyCount = 0;
+    int awakeBodyCount = 0;
+    int contactCount = 0;
+    int frozenBodyCount = 0;
+};
+
+/**
+ * @brief Percentiles of a phase over the frames in the ring buffer, in milliseconds
+ */
+struct PhaseStats {
+    float last = 0;
+    float p50 = 0;
+    float p95 = 0;
+    float p99 = 0;
+};
+
+/**
+ * @brief Singleton that records how long each phase of the game loop takes
+ *
+ * Samples are stored in a fixed ring buffer per phase, so recording and computing percentiles never allocate.
+ * Samples are always recorded, so the history is already filled when the overlay is opened.
+ * Samples are recorded on the main thread, phases that run on the physics thread are timed with ScopedTimer
+ * and added from the published snapshot. Input latencies are added by the render thread under a mutex.
+ */
+class FrameProfiler {
+    public:
+        enum class Phase {
+            Events,
+            Update,
+            Step,
+            Collisions,
+            ObjectState,
+            BirdState,
+            Camera,
+            HUD,
+            Render,
+            Frame, // Whole frame including the frame rate sleep
+            Count
+        };
+        static FrameProfiler& getInstance() {
+            static FrameProfiler instance;
+            return instance;
+        }
+        void beginFrame();
+        void addSample(Phase phase, float milliseconds);
+        void setPhysicsStats(const PhysicsStats& stats);
+        static PhysicsStats capturePhysicsStats(const b2World& world, bool countAwakeBodies);
+        float getSample(Phase phase, int framesAgo) const;
+        PhaseStats getStats(Phase phase) const;
+        void addInputLatency(float milliseconds);
+        PhaseStats getInputLatencyStats() const;
+        const PhysicsStats& getPhysicsStats() const;
+        int getFrameCount() const;
+        bool isEnabled() const;
+        void toggle();
+        static const char* getPhaseName(Phase phase);
+    private:
+        FrameProfiler();
+        FrameProfiler(const FrameProfiler&) = delete;
+        FrameProfiler& operator=(const FrameProfiler&) = delete;
+        static constexpr int PHASE_COUNT = static_cast<int>(Phase::Count);
+        std::array<std::array<float, PROFILER_HISTORY>, PHASE_COUNT> samples_ = {};
+        mutable std::array<float, PROFILER_HISTORY> sortBuffer_ = {}; // Scratch space for percentiles
+        PhysicsStats physicsStats_;
+        std::chrono::steady_clock::time_point frameStart_;
+        int frame_ = 0; // Index of the current frame in the ring buffer
+        int frameCount_ = 0; // Number of recorded frames, at most PROFILER_HISTORY
+        std::atomic<bool> isEnabled_{false}; // Read by the physics thread
+        // Input latencies are added by the render thread, they are only measured while the overlay is shown
+        mutable std::mutex latencyMutex_;
+        std::array<float, INPUT_LATENCY_HISTORY> latencySamples_ = {};
+        int latencyIndex_ = 0;
+        int latencyCount_ = 0;
+};
+
+/**
+ * @brief Records the time from construction to destruction as a sample of the given phase
+ */
+class ScopedPhase {
+    public:
+        ScopedPhase(FrameProfiler::Phase phase);
+        ~ScopedPhase();
+        ScopedPhase(const ScopedPhase&) = delete;
+        ScopedPhase& operator=(const ScopedPhase&) = delete;
+    private:
+        FrameProfiler::Phase phase_;
+        std::chrono::steady_clock::time_point start_;
+};
+
+/**
+ * @brief Writes the time from construction to destruction to the given float in milliseconds, usable from any thread
+ */
+class ScopedTimer {
+    public:
+        ScopedTimer(float& milliseconds);
+        ~ScopedTimer();
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    private:
+        float& milliseconds_;
+        std::chrono::steady_clock::time_point start_;
+};
+
+#endif // FRAME_PROFILER_HPP
@@ -1,17 +1,55 @@
 #include "game.hpp"
 #include "world.hpp"
+#include "frame_profiler.hpp"
+#include "trace.hpp"
+#include "alloc_tracker.hpp"
+#include "startup_profiler.hpp"
+#include <cstdlib>
 
-Game::Game() : model_(), view_(), controller_(model_, view_) {}
+Game::Game() : model_(), view_(), controller_(model_, view_) {
+    isWarmingUp_ = std::getenv("AB_NO_WARMUP") == nullptr;
+    StartupProfiler::getInstance().mark("GameController");
+}
 
 void Game::run() {
+    FrameProfiler& profiler = FrameProfiler::getInstance();
+    trace::setThreadName("Main");
     while (view_.isOpen()) {
         timer.restart();
-        controller_.handleEvents();
-        model_.update();
-        view_.updateCamera(model_);
-        view_.setGameView();
-        view_.updateHUD(model_);
-        view_.render(model_);
+        profiler.beginFrame();
+        AllocationTracker::getInstance().beginFrame();
+        TRACE_ZONE("Frame");
+        {
+            ScopedPhase phase(FrameProfiler::Phase::Events);
+            TRACE_ZONE("GameController::handleEvents");
+            ALLOC_TAG("Events");
+            controller_.handleEvents();
+        }
+        {
+            ScopedPhase phase(FrameProfiler::Phase::Update);
+            TRACE_ZONE("GameModel::update");
+            ALLOC_TAG("Update");
+            model_.update();
+        }
+        {
+            ScopedPhase phase(FrameProfiler::Phase::Camera);
+            TRACE_ZONE("GameView::updateCamera");
+            ALLOC_TAG("Camera");
+            view_.updateCamera(model_);
+            view_.setGameView();
+        }
+        {
+            ScopedPhase phase(FrameProfiler::Phase::HUD);
+            TRACE_ZONE("GameView::updateHUD");
+            ALLOC_TAG("HUD");
+            view_.updateHUD(model_);
+        }
+        {
+            ScopedPhase phase(FrameProfiler::Phase::Render);
+            TRACE_ZONE("GameView::render");
+            ALLOC_TAG("Render");
+            view_.render(model_);
+        }
         controlFrameRate();
     }
 }
@@ -19,6 +57,11 @@ void Game::run() {
 // For now use simple sleep to control frame rate. Later change to better frame rate control, e.g. interpolation
 void Game::controlFrameRate() {
     elapsedTime_ = timer.getElapsedTime().asSeconds();
+    if (isWarmingUp_ && elapsedTime_ < TIME_STEP * WARM_UP_IDLE_FRACTION) {
+        TRACE_ZONE("GameModel::warmUp");
+        isWarmingUp_ = model_.warmUp();
+        elapsedTime_ = timer.getElapsedTime().asSeconds();
+    }
     if (elapsedTime_ < TIME_STEP) {
         sf::sleep(sf::seconds(TIME_STEP - elapsedTime_));
     }
@@ -5,6 +5,8 @@
 #include "game_view.hpp"
 #include "game_controller.hpp"
 
+const float WARM_UP_IDLE_FRACTION = 0.5f; // Warm-up only runs in frames that used less than this fraction of TIME_STEP
+
 class Game {
     public:
         Game(); 
@@ -16,6 +18,7 @@ class Game {
         GameController controller_;
         float elapsedTime_ = 0;
         sf::Clock timer;
+        bool isWarmingUp_ = true; // Whether idle frames create the menus that haven't been used yet, disabled by AB_NO_WARMUP
         void controlFrameRate();
 };
 
@@ -1,16 +1,53 @@
 #include "game_controller.hpp"
+#include "trace.hpp"
+#include "frame_profiler.hpp"
+#include <iostream>
 
 
 GameController::GameController(GameModel& model, GameView& view) : model_(model), view_(view) {}
 
 void GameController::handleEvents() {
-    const sf::Vector2f& mousePosition = view_.mapPixelToCoords(sf::Mouse::getPosition(view_));
+    bool isLatencyMeasured = FrameProfiler::getInstance().isEnabled();
+    bool isStamped = false;
     for (auto event = sf::Event{}; view_.pollEvent(event);) {
-       handleEvent(event, mousePosition);
+        // Only the first input of a frame is stamped, so the latency is measured from the oldest input the frame shows
+        if (isLatencyMeasured && !isStamped && isInput(event)) {
+            view_.setInputTime(std::chrono::steady_clock::now());
+            isStamped = true;
+        }
+        if (event.type == sf::Event::MouseMoved) {
+            pendingMove_ = sf::Vector2i(event.mouseMove.x, event.mouseMove.y);
+            hasPendingMove_ = true;
+            continue;
+        }
+        // Keep the order of moves and other events, key presses also act on the hover and selection set by moves
+        applyPendingMove();
+        handleEvent(event);
     }
+    applyPendingMove();
 }
 
-void GameController::handleEvent(const sf::Event& event, const sf::Vector2f& mousePosition) {
+bool GameController::isInput(const sf::Event& event) {
+    switch (event.type) {
+        case sf::Event::KeyPressed:
+        case sf::Event::MouseButtonPressed:
+        case sf::Event::MouseButtonReleased:
+        case sf::Event::MouseMoved:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void GameController::applyPendingMove() {
+    if (!hasPendingMove_) {
+        return;
+    }
+    hasPendingMove_ = false;
+    handleMouseMove(view_.mapPixelToCoords(pendingMove_));
+}
+
+void GameController::handleEvent(const sf::Event& event) {
     switch (event.type) {
         case sf::Event::Closed:
             view_.close();
@@ -22,13 +59,10 @@ void GameController::handleEvent(const sf::Event& event, const sf::Vector2f& mou
             handleKeyRelease(event.key.code);
             break;
         case sf::Event::MouseButtonPressed:
-            handleMousePress(event.mouseButton.button, mousePosition);
+            handleMousePress(event.mouseButton.button, view_.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y)));
             break;
         case sf::Event::MouseButtonReleased:
-            handleMouseRelease(event.mouseButton.button, mousePosition);
-            break;
-        case sf::Event::MouseMoved:
-            handleMouseMove(mousePosition);
+            handleMouseRelease(event.mouseButton.button, view_.mapPixelToCoords(sf::Vector2i(event.mouseButton.x, event.mouseButton.y)));
             break;
         case sf::Event::TextEntered:
             handleTextEntered(event.text.unicode);
@@ -55,6 +89,7 @@ void GameController::handleKeyPress(const sf::Keyboard::Key& code) {
             break;
         case sf::Keyboard::Key::Enter:
         case sf::Keyboard::Key::R:
+        case sf::Keyboard::Key::U:
         case sf::Keyboard::Key::T:
         case sf::Keyboard::Key::A:
         case sf::Keyboard::Key::D:
@@ -68,6 +103,18 @@ void GameController::handleKeyPress(const sf::Keyboard::Key& code) {
             model_.handleKeyPress(code);
             model_.getMenu<Pause>(Menu::Type::PAUSE).updatePosition(view_);
             break;
+        case sf::Keyboard::Key::F3:
+            view_.toggleProfiler();
+            break;
+#ifdef AB_TRACING
+        case sf::Keyboard::Key::F4:
+            try {
+                trace::exportChromeTrace(utils::getExecutablePath() + "/trace.json");
+            } catch (const std::exception& e) {
+                std::cerr << "Failed to export trace: " << e.what() << std::endl;
+            }
+            break;
+#endif
         default:
             break;
     }
@@ -3,7 +3,17 @@
 
 #include "game_model.hpp"
 #include "game_view.hpp"
+#include <chrono>
 
+/**
+ * @brief Applies the window events to the model and the view
+ *
+ * Mouse events use the coordinates carried by the event, not the cursor position at the time of polling.
+ * Mouse moves are coalesced, only the latest move before each button event and at the end of the batch is applied,
+ * so a high polling rate mouse doesn't repeat the hit testing of the cannon and the level editor many times per frame.
+ * While the profiler overlay is shown, the time the first input of a frame was polled is passed to the view,
+ * and the render thread records the time from it to the present of the frame.
+ */
 class GameController {
     public:
         GameController(GameModel& model, GameView& view);
@@ -11,6 +21,10 @@ class GameController {
     private:
         GameModel& model_;
         GameView& view_;
+        sf::Vector2i pendingMove_; // Latest mouse move of the batch in pixels, not applied yet
+        bool hasPendingMove_ = false;
+        static bool isInput(const sf::Event& event);
+        void applyPendingMove();
         // Handle different types of events
         void handleKeyPress(const sf::Keyboard::Key& code);
         void handleKeyRelease(const sf::Keyboard::Key& code);
@@ -19,7 +33,7 @@ class GameController {
         void handleMouseMove(const sf::Vector2f& mousePosition);
         void handleTextEntered(const sf::Uint32& unicode);
         void handleResize(const sf::Event& event);
-        void handleEvent(const sf::Event& event, const sf::Vector2f& mousePosition);
+        void handleEvent(const sf::Event& event);
 
 };
 
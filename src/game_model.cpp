@@ -1,46 +1,78 @@
 #include "game_model.hpp"
 #include "utils.hpp"
 #include "game_view.hpp"
+#include "frame_profiler.hpp"
+#include "trace.hpp"
+#include "alloc_tracker.hpp"
+#include "music_service.hpp"
+#include "startup_profiler.hpp"
 #include <algorithm>
 
 GameModel::GameModel() :
     state_(State::MENU),
     world_(),
-    levelEditor_() {
-        menus_[Menu::Type::MAIN] = std::make_unique<MainMenu>();
-        menus_[Menu::Type::GAME_SELECTOR] = std::make_unique<GameSelector>();
-        menus_[Menu::Type::SETTINGS] = std::make_unique<Settings>();
-        menus_[Menu::Type::GAME_OVER] = std::make_unique<GameOver>();
-        menus_[Menu::Type::PAUSE] = std::make_unique<Pause>();
-        currentMenu_ = menus_[Menu::Type::MAIN].get();  // Start with main menu
+    physics_(world_) {
+        // Only the main menu is needed for the first frame, the other menus and the level editor are created on first use
+        currentMenu_ = &getMenu(Menu::Type::MAIN);  // Start with main menu
+        MusicService::getInstance().play(MusicService::Track::MENU);
+        StartupProfiler::getInstance().mark("GameModel");
     }
 
 void GameModel::update() {
+    AllocationTracker& tracker = AllocationTracker::getInstance();
     if (isRunning()) {
-        world_.step();
-
-        // Update the cannon if the bird is not launched
-        Bird* bird = world_.GetBird();
-        if (bird != nullptr && !bird->isLaunched()) {
-            world_.getCannon()->update();
+        physics_.resume();
+        tracker.setSteadyState(hasShot_);
+        updateWorld();
+    } else {
+        tracker.setSteadyState(false);
+        // The world is only stepped while running, so menus can use it freely
+        physics_.pause();
+        if (isLevelEditor()) {
+            getLevelEditor().update();
         }
-
-        // Check if level is ended and handle level ending
-        if (world_.isSettled()) {
-            handleLevelEnd();
+    }
+    MusicService::getInstance().update();
+}
+
+// Apply the latest snapshot of the physics thread and send the cannon input to it
+void GameModel::updateWorld() {
+    if (physics_.updateSnapshot()) {
+        // Physics phases run on the physics thread, record their timings from the snapshot
+        const WorldSnapshot& snapshot = physics_.getSnapshot();
+        FrameProfiler& profiler = FrameProfiler::getInstance();
+        profiler.addSample(FrameProfiler::Phase::Step, snapshot.phaseTimes[0]);
+        profiler.addSample(FrameProfiler::Phase::Collisions, snapshot.phaseTimes[1]);
+        profiler.addSample(FrameProfiler::Phase::ObjectState, snapshot.phaseTimes[2]);
+        profiler.addSample(FrameProfiler::Phase::BirdState, snapshot.phaseTimes[3]);
+        profiler.setPhysicsStats(snapshot.physicsStats);
+    }
+    const WorldSnapshot& snapshot = physics_.getSnapshot();
+    // Score and counter updates happen every time something is destroyed, they must not allocate
+    ASSERT_NO_ALLOCATIONS(world_.handleEvents());
+    world_.updateEffects();
+
+    // Update the cannon if the bird is not launched
+    if (snapshot.hasBird && !snapshot.isBirdLaunched) {
+        Cannon* cannon = world_.getCannon();
+        cannon->update();
+        if (cannon->isLaunching()) {
+            physics_.pushCommand({WorldCommand::Type::Aim, cannon->getDirection(), cannon->getPower()});
+            cannon->setTrajectory(snapshot.trajectory);
         }
-        // Handle collisions
-        world_.handleCollisions();
+    }
 
-        // Handle object state and bird state
-        world_.handleObjectState();
-        world_.handleBirdState();
-    } else if (isLevelEditor()) {
-        levelEditor_.update();
+    // Check if level is ended and handle level ending
+    if (snapshot.isSettled) {
+        AllocationTracker::getInstance().setSteadyState(false);
+        physics_.pause();
+        world_.handleEvents(); // Objects removed after the snapshot was published
+        handleLevelEnd();
     }
 }
 
 void GameModel::handleLevelEnd() {
+    TRACE_ZONE("GameModel::handleLevelEnd");
     // Set state, update score and player, and set Score for level end menu
     updateView_ = true; // Force view update to center the view
     switchMenu(Menu::Type::GAME_OVER, State::GAME_OVER);
@@ -66,21 +98,47 @@ void GameModel::setState(State state) {
     state_ = state;
 }
 
+// Creates the menu on first use
+Menu& GameModel::getMenu(const Menu::Type& type) {
+    std::unique_ptr<Menu>& menu = menus_[type];
+    if (!menu) {
+        menu = createMenu(type);
+    }
+    return *menu;
+}
+
+// The menu must already have been created by the non-const overload
 const Menu& GameModel::getMenu(const Menu::Type& type) const {
     return *menus_.at(type);
 }
 
-Menu& GameModel::getMenu(const Menu::Type& type) {
-    return *menus_.at(type);
+std::unique_ptr<Menu> GameModel::createMenu(Menu::Type type) {
+    TRACE_ZONE("GameModel::createMenu");
+    switch (type) {
+        case Menu::Type::MAIN:
+            return std::make_unique<MainMenu>();
+        case Menu::Type::GAME_SELECTOR:
+            return std::make_unique<GameSelector>();
+        case Menu::Type::SETTINGS:
+            return std::make_unique<Settings>();
+        case Menu::Type::GAME_OVER:
+            return std::make_unique<GameOver>();
+        case Menu::Type::PAUSE:
+            return std::make_unique<Pause>();
+    }
+    throw std::runtime_error("Unknown menu type");
 }
 
 void GameModel::setMenu(Menu::Type newMenuType) {
-    currentMenu_ = menus_.at(newMenuType).get();
+    currentMenu_ = &getMenu(newMenuType);
 }
 
 void GameModel::switchMenu(Menu::Type type, State state) {
     state_ = state;
     setMenu(type);
+    if (type == Menu::Type::MAIN) {
+        MusicService::getInstance().play(MusicService::Track::MENU);
+    }
 }
 
 void GameModel::handleKeyPress(const sf::Keyboard::Key& code) {
@@ -99,6 +157,8 @@ void GameModel::handleKeyPress(const sf::Keyboard::Key& code) {
         case sf::Keyboard::Key::P:
         case sf::Keyboard::Key::Escape:
             if (isRunning()) {
+                AllocationTracker::getInstance().setSteadyState(false);
+                physics_.pause();
                 switchMenu(Menu::Type::PAUSE, State::PAUSED);
                 world_.handleKeyPress(code);
             } else if (isPausedAtRunning()) {
@@ -115,16 +175,30 @@ void GameModel::handleKeyPress(const sf::Keyboard::Key& code) {
         case sf::Keyboard::Key::D:
         case sf::Keyboard::Key::S:
             if (isRunning()) {
-                world_.handleKeyPress(code);
+                WorldCommand command;
+                command.type = WorldCommand::Type::KeyPress;
+                command.key = code;
+                physics_.pushCommand(command);
             } else if (isLevelEditor()) {
-                levelEditor_.handleKeyPress(code);
+                getLevelEditor().handleKeyPress(code);
             }
             break;
         case sf::Keyboard::Key::R:
+            if (isRunning()) {
+                restartLevel();
+            } else if (isLevelEditor()) {
+                getLevelEditor().handleKeyPress(code);
+            }
+            break;
+        case sf::Keyboard::Key::U:
+            if (isRunning()) {
+                undoShot();
+            }
+            break;
         case sf::Keyboard::Key::T:
         case sf::Keyboard::Key::Delete:
             if (isLevelEditor()) {
-                levelEditor_.handleKeyPress(code);
+                getLevelEditor().handleKeyPress(code);
             }
             break;
         default:
@@ -134,7 +208,7 @@ void GameModel::handleKeyPress(const sf::Keyboard::Key& code) {
 
 void GameModel::handleKeyRelease() {
     if (isLevelEditor()) {
-        levelEditor_.handleKeyRelease();
+        getLevelEditor().handleKeyRelease();
     }
 }
 
@@ -172,10 +246,11 @@ void GameModel::handleMainMenuState() {
         pauseMenu.updateMenuItems();
         switchMenu(Menu::Type::GAME_SELECTOR, State::GAME_SELECTOR);
     } else if (selectedItem == 1) {
-        currentMenu_->updateMusic(sf::SoundSource::Status::Stopped);
+        MusicService::getInstance().play(MusicService::Track::EDITOR);
         auto& pauseMenu = getMenu<Pause>(Menu::Type::PAUSE);
         pauseMenu.setPausedState(Pause::PausedState::LEVEL_EDITOR);
         pauseMenu.updateMenuItems();
+        getLevelEditor(); // Created when the editor is entered, draw is const and can't create it
         state_ = State::LEVEL_EDITOR;
     } else if (selectedItem == 2) {
         switchMenu(Menu::Type::SETTINGS, State::SETTINGS);
@@ -198,18 +273,20 @@ void GameModel::handleGameOverState() {
     }
     if (selectedItem == 0) {
         // Restart
-        world_.resetLevel();
+        restartLevel();
         state_ = State::RUNNING;
     } else if (selectedItem == nextLevelIndex) {
         auto &gameSelector = getMenu<GameSelector>(Menu::Type::GAME_SELECTOR);
         // Next Level
+        physics_.pause();
         world_.clearLevel();
         world_.loadLevel(gameSelector.getLevelSelector().getNextLevel().filename);
+        physics_.refreshSnapshot();
+        hasShot_ = false;
         state_ = State::RUNNING;
     } else if (selectedItem == mainMenuIndex) {
         // Main Menu
         switchMenu(Menu::Type::MAIN, State::MENU);
-        currentMenu_->updateMusic(sf::SoundSource::Status::Playing);
     } else if (selectedItem == exitIndex) {
         // Exit
         state_ = State::QUIT;
@@ -295,10 +372,13 @@ void GameModel::handleLevelSelectorScreenState() {
             gameSelector.setScreen(GameSelector::Screen::GAME_SELECTOR);
             break;
         case LevelSelector::Item::LEVEL:
+            physics_.pause();
             world_.clearLevel();
             world_.loadLevel(levelSelector.getSelectedLevel().filename);
             world_.setPlayer(gameSelector.getUserSelector().getPlayer());
-            getMenu(Menu::Type::MAIN).updateMusic(sf::SoundSource::Status::Stopped);
+            physics_.refreshSnapshot();
+            hasShot_ = false;
+            MusicService::getInstance().play(MusicService::Track::LEVEL);
             state_ = State::RUNNING;
             break;
         case LevelSelector::Item::NEXT: 
@@ -340,7 +420,7 @@ void GameModel::handlePauseState() {
                 world_.handleKeyPress(sf::Keyboard::Key::P); // Unpause
                 state_ = State::RUNNING;
             } else if (selectedItem == 1) {
-                world_.resetLevel();
+                restartLevel();
                 state_ = State::RUNNING;
             } else if (selectedItem == 2) {
                 switchMenu(Menu::Type::MAIN, State::MENU);
@@ -374,9 +454,39 @@ const World &GameModel::getWorld() const {
     return world_;
 }
 
+const WorldSnapshot& GameModel::getSnapshot() const {
+    return physics_.getSnapshot();
+}
+
 void GameModel::launchBird() {
-    Bird* bird = world_.GetBird();
-    world_.getCannon()->launchBird(bird);
+    const WorldSnapshot& snapshot = physics_.getSnapshot();
+    Cannon* cannon = world_.getCannon();
+    if (!snapshot.hasBird || snapshot.isBirdLaunched) {
+        cannon->stopLaunch();
+        return;
+    }
+    cannon->launch();
+    // Save the world before the shot for undo, the physics thread continues on the next update
+    physics_.pause();
+    world_.saveShotState();
+    physics_.pushCommand({WorldCommand::Type::Launch, cannon->getDirection(), cannon->getPower()});
+    hasShot_ = true;
+}
+
+// Restores the state of the level when it was loaded, without reloading the level file
+void GameModel::restartLevel() {
+    physics_.pause();
+    world_.resetLevel();
+    physics_.refreshSnapshot();
+    hasShot_ = false;
+}
+
+// Returns to the state before the last launched bird was fired
+void GameModel::undoShot() {
+    physics_.pause();
+    if (world_.undoShot()) {
+        physics_.refreshSnapshot();
+    }
 }
 
 void GameModel::handleTextEntered(const sf::Uint32& unicode) {
@@ -389,7 +499,7 @@ void GameModel::handleMouseMove(const sf::Vector2f& mousePosition) {
     if (isRunning()) {
         world_.handleMouseMove(mousePosition);
     } else if (isLevelEditor()) {
-        levelEditor_.handleMouseMove(mousePosition);
+        getLevelEditor().handleMouseMove(mousePosition);
     } else {
         currentMenu_->handleMouseMove(mousePosition);
     }
@@ -403,8 +513,12 @@ void GameModel::handleResize(const sf::RenderWindow& window) {
             menu.second->handleResize();
         }
     }
+    physics_.pause();
     world_.handleResize();
-    levelEditor_.handleResize();
+    physics_.refreshSnapshot();
+    if (levelEditor_) {
+        levelEditor_->handleResize();
+    }
 }
 
 void GameModel::handleMouseLeftClick(const sf::Vector2f& mousePosition, GameView& view) {
@@ -412,7 +526,7 @@ void GameModel::handleMouseLeftClick(const sf::Vector2f& mousePosition, GameView
         view.setUpdateHUD(true);
         world_.getCannon()->startLaunch();
     } else if (isLevelEditor()) {
-        levelEditor_.handleMouseClick(mousePosition, view);
+        getLevelEditor().handleMouseClick(mousePosition, view);
     } else {
         if (currentMenu_->handleMouseClick(mousePosition)) {
             setState();
@@ -422,7 +536,7 @@ void GameModel::handleMouseLeftClick(const sf::Vector2f& mousePosition, GameView
 
 void GameModel::handleMouseRightClick(const sf::Vector2f& mousePosition) {
     if (isRunning()) {
-        world_.useBirdPower();
+        physics_.pushCommand({WorldCommand::Type::UsePower});
     }
 }
 
@@ -431,22 +545,26 @@ void GameModel::handleMouseRelease(const sf::Mouse::Button& button, const sf::Ve
         if (isRunning() && world_.getCannon()->isLaunching()) {
             launchBird();
         } else if (isLevelEditor()) {
-            levelEditor_.handleMouseRelease();
+            getLevelEditor().handleMouseRelease();
         }
     }
 
 }
 
-void GameModel::draw(sf::RenderWindow& window) const {
+void GameModel::draw(RenderQueue& window) const {
     if (isRunning()) {
-        world_.draw(window);
+        world_.draw(window, physics_.getSnapshot());
     } else if (isPausedAtRunning()) {
-        world_.draw(window);
+        world_.draw(window, physics_.getSnapshot());
         currentMenu_->draw(window);
     } else if (isLevelEditor()) {
-        levelEditor_.draw(window);
+        if (levelEditor_) {
+            levelEditor_->draw(window);
+        }
     } else if (isPaused()) {
-        levelEditor_.draw(window);
+        if (levelEditor_) {
+            levelEditor_->draw(window);
+        }
         currentMenu_->draw(window);
     } else {
         currentMenu_->draw(window);
@@ -473,11 +591,59 @@ void GameModel::setUpdateView(bool updateView) {
     updateView_ = updateView;
 }
 
+// The physics thread streams the chunks of wide levels around the camera, impacts are heard from the camera center
+void GameModel::setCameraCenter(const sf::Vector2f& center) {
+    world_.setListenerPosition(center);
+    if (!isRunning() || center.x == cameraCenterX_) {
+        return;
+    }
+    WorldCommand command;
+    command.type = WorldCommand::Type::Camera;
+    command.cameraX = center.x / SCALE;
+    if (physics_.pushCommand(command)) {
+        cameraCenterX_ = center.x;
+    }
+}
+
 bool GameModel::isLevelEditor() const {
     return state_ == State::LEVEL_EDITOR;
 }
 
 
 LevelEditor& GameModel::getLevelEditor() {
-    return levelEditor_;
+    if (!levelEditor_) {
+        TRACE_ZONE("GameModel::createLevelEditor");
+        levelEditor_ = std::make_unique<LevelEditor>();
+    }
+    return *levelEditor_;
+}
+
+// Creates the next menu or screen that hasn't been used yet, called while the main menu is idle so their first use doesn't stall.
+// Returns whether there is something left to create
+bool GameModel::warmUp() {
+    if (state_ == State::MENU) {
+        switch (warmUpStep_++) {
+            case 0:
+                getMenu(Menu::Type::GAME_SELECTOR);
+                break;
+            case 1:
+                getMenu(Menu::Type::SETTINGS);
+                break;
+            case 2:
+                getMenu(Menu::Type::PAUSE);
+                break;
+            case 3:
+                getMenu(Menu::Type::GAME_OVER);
+                break;
+            case 4:
+                getMenu<GameSelector>(Menu::Type::GAME_SELECTOR).getLevelSelector();
+                break;
+            case 5:
+                getLevelEditor();
+                break;
+            default:
+                break;
+        }
+    }
+    return warmUpStep_ < WARM_UP_STEP_COUNT;
 }
\ No newline at end of file
@@ -9,10 +9,13 @@
 #include "world.hpp"
 #include <type_traits>
 #include "level_editor.hpp"
+#include "physics_thread.hpp"
 
 // Forward declare GameView
 class GameView;
 
+const int WARM_UP_STEP_COUNT = 6; // Menus and screens created by GameModel::warmUp
+
 class GameModel {
     public:
         GameModel();   
@@ -48,6 +51,7 @@ class GameModel {
         void handleKeyRelease();
         World &getWorld();
         const World &getWorld() const;
+        const WorldSnapshot& getSnapshot() const;
         void launchBird();
         void handleTextEntered(const sf::Uint32& unicode);
         void handleMouseMove(const sf::Vector2f& mousePosition);
@@ -55,7 +59,7 @@ class GameModel {
         void handleMouseLeftClick(const sf::Vector2f& mousePosition, GameView& view);
         void handleMouseRightClick(const sf::Vector2f& mousePosition);
         void handleMouseRelease(const sf::Mouse::Button& button, const sf::Vector2f& mousePosition);
-        void draw(sf::RenderWindow& window) const;
+        void draw(RenderQueue& window) const;
         void switchMenu(Menu::Type type, State state);
         bool isRunning() const;
         bool isPaused() const;
@@ -63,14 +67,24 @@ class GameModel {
         bool isLevelEditor() const;
         bool updateView() const;
         void setUpdateView(bool updateView);
+        void setCameraCenter(const sf::Vector2f& center);
         LevelEditor& getLevelEditor();
+        bool warmUp();
     private:
         State state_;
-        std::unordered_map<Menu::Type, std::unique_ptr<Menu>> menus_;
+        std::unordered_map<Menu::Type, std::unique_ptr<Menu>> menus_; // Created on first use
         Menu *currentMenu_;
         World world_;
-        LevelEditor levelEditor_;
+        std::unique_ptr<LevelEditor> levelEditor_; // Created on first use
+        int warmUpStep_ = 0; // Next object created by warmUp
+        static std::unique_ptr<Menu> createMenu(Menu::Type type);
+        PhysicsThread physics_; // Declared after world_ so the thread is stopped before the world is destroyed
         bool updateView_ = false;
+        float cameraCenterX_ = 0; // Last camera position sent to the physics thread
+        bool hasShot_ = false; // Whether a bird has been launched in the current level, the loop is in its steady state after it
+        void updateWorld();
+        void restartLevel();
+        void undoShot();
         void handleLevelEnd();
         void handleMainMenuState();
         void handleGameOverState();
@@ -48,7 +48,7 @@ void GameOver::setScoreManager(Score* scoreManager) {
     clock_.restart();
 }
 
-void GameOver::drawStars(int stars, sf::RenderWindow& window) const {
+void GameOver::drawStars(int stars, RenderQueue& window) const {
     sf::Time elapsed = clock_.getElapsedTime();
     if (elapsed.asSeconds() > 3 && stars == 3) {
         window.draw(starSprites_[3]);
@@ -63,7 +63,7 @@ void GameOver::drawStars(int stars, sf::RenderWindow& window) const {
 
 }
 
-void GameOver::draw(sf::RenderWindow& window) const {
+void GameOver::draw(RenderQueue& window) const {
     window.draw(background_);
     window.draw(woodenSign_);
     drawStars(scoreManager_->getStars(), window);
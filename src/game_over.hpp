@@ -8,8 +8,8 @@ class GameOver: public Menu {
     public:
         GameOver();
         void setScoreManager(Score* score);
-        void draw(sf::RenderWindow& window) const override;
-        void drawStars(int stars, sf::RenderWindow& window) const;
+        void draw(RenderQueue& window) const override;
+        void drawStars(int stars, RenderQueue& window) const;
         void handleResize() override;
         bool hasNextLevel() const;
         void setHasNextlevel(bool hasNextLevl);
@@ -1,7 +1,7 @@
 #include "game_selector.hpp"
 
 
-GameSelector::GameSelector() : Menu(Menu::Type::GAME_SELECTOR), levelSelector_(), userSelector_() {
+GameSelector::GameSelector() : Menu(Menu::Type::GAME_SELECTOR), userSelector_() {
     // Create menu items
     updateMenuItems();
     setTitle("AngryBirds", 680.f, 340);
@@ -12,16 +12,18 @@ void GameSelector::handleResize() {
     title_.clear();
     setTitle("AngryBirds", 680.f, 340);
     userSelector_.handleResize();
-    levelSelector_.handleResize();
+    if (levelSelector_) {
+        levelSelector_->handleResize();
+    }
 };
 
-void GameSelector::drawScreen(sf::RenderWindow& window) const {
+void GameSelector::drawScreen(RenderQueue& window) const {
     switch (screen_) {
         case GameSelector::Screen::USER_SELECTOR:
             userSelector_.draw(window);
             break;
         case GameSelector::Screen::LEVEL_SELECTOR:
-            levelSelector_.draw(window);
+            levelSelector_->draw(window); // Created when the screen was set
             break;
         default:
             // Game selector screen
@@ -32,7 +34,7 @@ void GameSelector::drawScreen(sf::RenderWindow& window) const {
     }
 }
 
-void GameSelector::draw(sf::RenderWindow& window) const {
+void GameSelector::draw(RenderQueue& window) const {
     window.draw(background_);
     window.draw(woodenSign_);
     // Draw the title characters
@@ -47,11 +49,17 @@ GameSelector::Screen GameSelector::getScreen() const {
 };
 
 void GameSelector::setScreen(GameSelector::Screen screen) {
+    if (screen == GameSelector::Screen::LEVEL_SELECTOR) {
+        getLevelSelector();
+    }
     screen_ = screen;
 };
 
 LevelSelector& GameSelector::getLevelSelector() {
-    return levelSelector_;
+    if (!levelSelector_) {
+        levelSelector_ = std::make_unique<LevelSelector>();
+    }
+    return *levelSelector_;
 };
 
 UserSelector& GameSelector::getUserSelector() {
@@ -64,7 +72,7 @@ void GameSelector::handleMouseMove(const sf::Vector2f& mousePosition) {
             this->Menu::handleMouseMove(mousePosition);
             break;
         case GameSelector::Screen::LEVEL_SELECTOR:
-            levelSelector_.handleMouseMove(mousePosition);
+            getLevelSelector().handleMouseMove(mousePosition);
             break;
         case GameSelector::Screen::USER_SELECTOR:
             userSelector_.handleMouseMove(mousePosition);
@@ -79,7 +87,7 @@ bool GameSelector::handleMouseClick(const sf::Vector2f& mousePosition) {
         case GameSelector::Screen::GAME_SELECTOR:
             return this->Menu::handleMouseClick(mousePosition);
         case GameSelector::Screen::LEVEL_SELECTOR:
-            return levelSelector_.handleMouseClick(mousePosition);
+            return getLevelSelector().handleMouseClick(mousePosition);
         case GameSelector::Screen::USER_SELECTOR:
             return userSelector_.handleMouseClick(mousePosition);
         default:
@@ -94,7 +102,7 @@ void GameSelector::handleKeyPress(const sf::Keyboard::Key& code) {
             this->Menu::handleKeyPress(code);
             break;
         case GameSelector::Screen::LEVEL_SELECTOR:
-            levelSelector_.handleKeyPress(code);
+            getLevelSelector().handleKeyPress(code);
             break;
         case GameSelector::Screen::USER_SELECTOR:
             userSelector_.handleKeyPress(code);
@@ -143,9 +151,10 @@ const std::vector<std::string>& GameSelector::getButtonNames() const {
 }
 
 void GameSelector::initializeLevelSelector() {
-    levelSelector_.setPlayer(userSelector_.getPlayer());
-    levelSelector_.addNewLevel(); // TODO: Check if changes are needed
-    levelSelector_.updateLevel();
+    LevelSelector& levelSelector = getLevelSelector();
+    levelSelector.setPlayer(userSelector_.getPlayer());
+    levelSelector.addNewLevel(); // TODO: Check if changes are needed
+    levelSelector.updateLevel();
     setScreen(GameSelector::Screen::LEVEL_SELECTOR);
 }
 
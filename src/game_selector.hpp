@@ -4,6 +4,7 @@
 #include "menu.hpp"
 #include "level_selector.hpp"
 #include "user_selector.hpp"
+#include <memory>
 
 class GameSelector : public Menu {
     public:
@@ -20,7 +21,7 @@ class GameSelector : public Menu {
             UNDEFINED
         };
         GameSelector();
-        void draw(sf::RenderWindow& window) const override;
+        void draw(RenderQueue& window) const override;
         LevelSelector& getLevelSelector();
         UserSelector& getUserSelector();
         void setScreen(Screen screen);
@@ -33,10 +34,10 @@ class GameSelector : public Menu {
         Item getSelectedItem() const;
         void initializeLevelSelector();
     private:
-        LevelSelector levelSelector_;
+        std::unique_ptr<LevelSelector> levelSelector_; // Created on first use, it scans the level and screenshot directories
         UserSelector userSelector_;
         Screen screen_ = Screen::GAME_SELECTOR;
-        void drawScreen(sf::RenderWindow& window) const;
+        void drawScreen(RenderQueue& window) const;
         const std::vector<std::string>& getButtonNames() const override;
 
 };
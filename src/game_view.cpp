@@ -1,10 +1,12 @@
 #include "game_view.hpp"
 #include "game_model.hpp"
 #include "utils.hpp"
+#include "startup_profiler.hpp"
 
-GameView::GameView() : sf::RenderWindow(sf::VideoMode(VIEW.getWidth(), VIEW.getHeight()), "Angry Birds") {
+GameView::GameView() : sf::RenderWindow(sf::VideoMode(VIEW.getWidth(), VIEW.getHeight()), "Angry Birds"), renderThread_(*this) {
     gameView_ = this->getDefaultView();
     defaultCenter_ = this->getDefaultView().getCenter();
+    StartupProfiler::getInstance().mark("GameView");
 }
 
 void GameView::setGameView() {
@@ -25,14 +27,14 @@ void GameView::setGameView(const sf::View& view) {
 }
 
 void GameView::updateCamera(GameModel& model) {
-    const World& world = model.getWorld();
     if (model.isRunning()) {
-        const Bird* activeBird = world.GetBird();
-        if (activeBird && activeBird->isMoving()) {
-            sf::Vector2f birdPosition = utils::B2ToSfCoords(activeBird->getBody()->GetPosition());
+        // The bird is owned by the physics thread, follow its position in the latest snapshot
+        const WorldSnapshot& snapshot = model.getSnapshot();
+        if (snapshot.hasBird && snapshot.isBirdMoving) {
+            sf::Vector2f birdPosition = snapshot.birdPosition;
             auto height = VIEW.getHeight();
             auto worldTop = -height + 200; // Take into account how worlds bg is positioned
-            gameView_.setCenter(std::min(std::max(birdPosition.x, defaultCenter_.x), WORLD_WIDTH - (gameView_.getSize().x*0.5f)), std::max(std::min(birdPosition.y, defaultCenter_.y), worldTop + (0.5f*height)));
+            gameView_.setCenter(std::min(std::max(birdPosition.x, defaultCenter_.x), utils::getWorldWidth() - (gameView_.getSize().x*0.5f)), std::max(std::min(birdPosition.y, defaultCenter_.y), worldTop + (0.5f*height)));
             manualControl_ = false;
             updateView_ = true;
         } else if (!manualControl_) {
@@ -45,6 +47,7 @@ void GameView::updateCamera(GameModel& model) {
         updateView_ = true;
         model.setUpdateView(false);
     }
+    model.setCameraCenter(gameView_.getCenter());
 }
 
 void GameView::updateCamera(const sf::Keyboard::Key& code) {
@@ -57,7 +60,7 @@ void GameView::updateCamera(const sf::Keyboard::Key& code) {
         updateView_ = true;
     } else if (code == sf::Keyboard::Key::Right) {
         auto centerPosition = gameView_.getCenter();
-        gameView_.setCenter(std::min(centerPosition.x + 10, WORLD_WIDTH - (gameView_.getSize().x*0.5f)), centerPosition.y);
+        gameView_.setCenter(std::min(centerPosition.x + 10, utils::getWorldWidth() - (gameView_.getSize().x*0.5f)), centerPosition.y);
         updateView_ = true;
     } else if (code == sf::Keyboard::Key::Up) {
         auto centerPosition = gameView_.getCenter();
@@ -96,20 +99,49 @@ void GameView::handleResize(const float& width, const float& height) {
     updateHUD_ = true;
 }
 
+// Records the frame and hands it to the render thread, the draw calls are executed there
 void GameView::render(const GameModel& model) {
-    this->clear(sf::Color::Blue);
-    draw(model);
-    this->display();
-}
-
-void GameView::draw(const GameModel& model) {
     if (model.getState() == GameModel::State::QUIT) {
         this->close();
-    } else {
-        model.draw(*this);
+        return;
+    }
+    RenderQueue& queue = renderThread_.getQueue();
+    queue.reset(*this);
+    if (hasInputTime_) {
+        queue.setInputTime(inputTime_);
+        hasInputTime_ = false;
     }
+    queue.clear(sf::Color::Blue);
+    model.draw(queue);
+    profilerOverlay_.update();
+    profilerOverlay_.draw(queue);
+    if (!isFrameSubmitted_) {
+        // Last startup mark of the main thread, the render thread may read the marks after the submit
+        StartupProfiler::getInstance().mark("First frame submitted");
+        isFrameSubmitted_ = true;
+    }
+    renderThread_.submit();
+}
+
+void GameView::close() {
+    renderThread_.stop();
+    sf::RenderWindow::close();
+}
+
+sf::Image GameView::capture() {
+    return renderThread_.capture();
 }
 
 void GameView::setUpdateHUD(bool updateHUD) {
     updateHUD_ = updateHUD;
 }
+
+void GameView::toggleProfiler() {
+    FrameProfiler::getInstance().toggle();
+}
+
+// Input latency is measured from this time to the present of the next frame
+void GameView::setInputTime(std::chrono::steady_clock::time_point time) {
+    inputTime_ = time;
+    hasInputTime_ = true;
+}
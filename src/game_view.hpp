@@ -3,12 +3,15 @@
 
 #include <SFML/Graphics.hpp>
 #include "game_model.hpp"
+#include "profiler_overlay.hpp"
+#include "render_thread.hpp"
 
 class GameView: public sf::RenderWindow {
     public:
         GameView();
-        void draw(const GameModel& model);
         void render(const GameModel& model);
+        void close(); // Hides sf::Window::close, the render thread has to stop before the context is destroyed
+        sf::Image capture();
         void updateCamera(GameModel& model);
         void updateCamera(const sf::Keyboard::Key& code);
         void updateHUD(GameModel& model);
@@ -16,12 +19,19 @@ class GameView: public sf::RenderWindow {
         void setGameView(const sf::View& view);
         void handleResize(const float& width, const float& height);
         void setUpdateHUD(bool updateHUD);
+        void toggleProfiler();
+        void setInputTime(std::chrono::steady_clock::time_point time);
     private:
+        ProfilerOverlay profilerOverlay_;
+        RenderThread renderThread_;
         sf::Vector2f defaultCenter_;
         sf::View gameView_;
         bool manualControl_ = true;
         bool updateView_ = false;
         bool updateHUD_ = false;
+        std::chrono::steady_clock::time_point inputTime_; // Time the first input not yet shown by a frame was polled
+        bool hasInputTime_ = false;
+        bool isFrameSubmitted_ = false; // Whether the first frame has been submitted, for the startup timeline
 };
 
 #endif // GAME_VIEW_HPP
\ No newline at end of file
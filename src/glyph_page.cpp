@@ -0,0 +1,33 @@
+#include "glyph_page.hpp"
+#include <cstring>
+#include <map>
+
+GlyphPage& GlyphPage::get(const sf::Font& font, unsigned int characterSize) {
+    static std::map<std::pair<const sf::Font*, unsigned int>, std::unique_ptr<GlyphPage>> pages;
+    auto& page = pages[{&font, characterSize}];
+    if (page == nullptr) {
+        page = std::make_unique<GlyphPage>(font, characterSize);
+    }
+    return *page;
+}
+
+GlyphPage::GlyphPage(const sf::Font& font, unsigned int characterSize) : font_(font), characterSize_(characterSize) {}
+
+// The glyph must already be loaded into the font, a glyph the copy doesn't contain makes it stale
+void GlyphPage::addGlyph(sf::Uint32 codePoint, bool isBold, float outlineThickness) {
+    uint32_t outlineBits;
+    std::memcpy(&outlineBits, &outlineThickness, sizeof(outlineBits));
+    uint64_t key = (static_cast<uint64_t>(outlineBits) << 32) | (codePoint << 1) | (isBold ? 1u : 0u);
+    if (glyphs_.insert(key).second) {
+        isStale_ = true;
+    }
+}
+
+// Glyphs keep their place when a page grows, so an older copy is still valid for the glyphs it contains
+const std::shared_ptr<const sf::Texture>& GlyphPage::getTexture() {
+    if (isStale_) {
+        texture_ = std::make_shared<const sf::Texture>(font_.getTexture(characterSize_));
+        isStale_ = false;
+    }
+    return texture_;
+}
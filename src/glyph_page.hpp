@@ -0,0 +1,31 @@
+#ifndef GLYPH_PAGE_HPP
+#define GLYPH_PAGE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+
+/**
+ * @brief Copy of a font's glyph page that recorded frames sample, only used by the main thread
+ *
+ * Looking up a glyph that isn't cached yet writes into the font's page texture or replaces it with a bigger one,
+ * so the render thread must never sample the font's own texture. Recorded glyphs point into a copy of the page
+ * that is never changed. A new copy is made when a frame draws a glyph the current copy doesn't contain,
+ * queues keep the copies they use alive until they are recorded again.
+ */
+class GlyphPage {
+    public:
+        static GlyphPage& get(const sf::Font& font, unsigned int characterSize);
+        GlyphPage(const sf::Font& font, unsigned int characterSize);
+        void addGlyph(sf::Uint32 codePoint, bool isBold, float outlineThickness);
+        const std::shared_ptr<const sf::Texture>& getTexture();
+    private:
+        const sf::Font& font_;
+        unsigned int characterSize_;
+        std::shared_ptr<const sf::Texture> texture_;
+        std::unordered_set<uint64_t> glyphs_; // Glyphs drawn from the page, all of them are in the copy unless it is stale
+        bool isStale_ = true;
+};
+
+#endif // GLYPH_PAGE_HPP
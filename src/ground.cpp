@@ -2,7 +2,7 @@
 #include "utils.hpp"
 
 
-Ground::Ground(b2Body *body, float hx, float hy) : Object(body, Type::Ground, "/assets/images/ground.png") {
+Ground::Ground(b2Body *body, float hx, float hy, const sf::Texture& texture) : Object(body, Type::Ground, texture), halfWidth_(hx) {
     float width = static_cast<float>(sprite_.getTextureRect().width);
     float height = static_cast<float>(sprite_.getTextureRect().height);
     float heightSf = utils::B2ToSf(2.f * hy);
@@ -11,19 +11,19 @@ Ground::Ground(b2Body *body, float hx, float hy) : Object(body, Type::Ground, "/
     float scaleFactor = utils::getScaleFactor(width, height, utils::B2ToSf(2.f * hx), heightSf);
     sprite_.setScale(scaleFactor, scaleFactor);
     sf::Vector2f centerPosition = utils::B2ToSfCoords(body->GetPosition());
-    sprite_.setPosition(0, centerPosition.y - heightSf * 1.2f);
+    sprite_.setPosition(utils::B2ToSf(body->GetPosition().x - hx), centerPosition.y - heightSf * 1.2f);
 }
 
 char Ground::getTypeAsChar() const {
     return 'G';
 }
 
-void Ground::update() {
+void Ground::updateTransform() {
     b2Vec2 position = body_->GetPosition();
     sf::Sprite& sprite = this->getSprite();
     sf::Vector2f centerPosition = utils::B2ToSfCoords(position);
     float heightSf = 100.f;
-    sprite_.setPosition(0, centerPosition.y - heightSf * 1.2f);
+    sprite_.setPosition(utils::B2ToSf(position.x - halfWidth_), centerPosition.y - heightSf * 1.2f);
 }
 
 bool Ground::isMoving() const {
@@ -3,12 +3,17 @@
 
 #include "object.hpp"
 
+const std::string GROUND_TEXTURE = "/assets/images/ground.png";
+
 class Ground : public Object {
     public:
-        Ground(b2Body *body, float hx, float hy);
+        Ground(b2Body *body, float hx, float hy, const sf::Texture& texture);
         char getTypeAsChar() const override;
-        void update() override;
         bool isMoving() const override;
+    protected:
+        void updateTransform() override;
+    private:
+        float halfWidth_; // Half width of the body, ground of a chunk doesn't start from the left edge of the world
 };
 
 #endif // GROUND_HPP
\ No newline at end of file
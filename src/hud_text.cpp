@@ -0,0 +1,199 @@
+#include "hud_text.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+    bool isWhitespace(char character) {
+        return character == ' ' || character == '\t';
+    }
+
+    sf::Uint32 toCodePoint(char character) {
+        return static_cast<unsigned char>(character);
+    }
+}
+
+HudText::HudText() {
+    text_[0] = '\0';
+}
+
+void HudText::setFont(const sf::Font& font, unsigned int characterSize) {
+    font_ = &font;
+    characterSize_ = characterSize;
+    warmGlyphs(HUD_TEXT_DIGITS);
+    rebuild();
+}
+
+void HudText::setFillColor(const sf::Color& color) {
+    fillColor_ = color;
+    rebuild();
+}
+
+void HudText::setOutline(const sf::Color& color, float thickness) {
+    outlineColor_ = color;
+    outlineThickness_ = thickness;
+    warmGlyphs(HUD_TEXT_DIGITS);
+    rebuild();
+}
+
+// Rebuilds the quads from the first changed character, unchanged characters that didn't move are kept
+void HudText::setText(const char* text) {
+    size_t length = std::min(std::strlen(text), HUD_TEXT_CAPACITY);
+    size_t first = 0;
+    while (first < length && first < length_ && text_[first] == text[first]) {
+        first++;
+    }
+    if (first == length && length == length_) {
+        return;
+    }
+    size_t previousLength = length_;
+    length_ = length;
+    if (font_ == nullptr) {
+        std::memcpy(text_.data(), text, length);
+        text_[length] = '\0';
+        return;
+    }
+    float x = 0.f;
+    sf::Uint32 previous = 0;
+    if (first > 0) {
+        previous = toCodePoint(text_[first - 1]);
+        x = penPositions_[first - 1] + getAdvance(text_[first - 1]);
+    }
+    for (size_t i = first; i < length; i++) {
+        sf::Uint32 current = toCodePoint(text[i]);
+        x += font_->getKerning(previous, current, characterSize_);
+        bool isChanged = i >= previousLength || text_[i] != text[i] || penPositions_[i] != x;
+        text_[i] = text[i];
+        penPositions_[i] = x;
+        if (isChanged) {
+            updateGlyph(i);
+        }
+        x += getAdvance(text[i]);
+        previous = current;
+    }
+    text_[length] = '\0';
+    updateBounds();
+}
+
+const char* HudText::getText() const {
+    return text_.data();
+}
+
+sf::FloatRect HudText::getLocalBounds() const {
+    return bounds_;
+}
+
+sf::FloatRect HudText::getGlobalBounds() const {
+    return getTransform().transformRect(bounds_);
+}
+
+void HudText::draw(RenderQueue& window) const {
+    if (font_ == nullptr || length_ == 0) {
+        return;
+    }
+    GlyphPage& page = GlyphPage::get(*font_, characterSize_);
+    for (size_t i = 0; i < length_; i++) {
+        if (isWhitespace(text_[i])) {
+            continue;
+        }
+        page.addGlyph(toCodePoint(text_[i]), false, 0);
+        if (outlineThickness_ != 0) {
+            page.addGlyph(toCodePoint(text_[i]), false, outlineThickness_);
+        }
+    }
+    const sf::Texture* texture = window.useGlyphPage(page);
+    if (outlineThickness_ != 0) {
+        window.draw(outlineVertices_.data(), length_ * 4, sf::Quads, texture, getTransform());
+    }
+    window.draw(fillVertices_.data(), length_ * 4, sf::Quads, texture, getTransform());
+}
+
+void HudText::warmGlyphs(const char* characters) const {
+    if (font_ == nullptr) {
+        return;
+    }
+    for (const char* character = characters; *character != '\0'; character++) {
+        font_->getGlyph(toCodePoint(*character), characterSize_, false);
+        if (outlineThickness_ != 0) {
+            font_->getGlyph(toCodePoint(*character), characterSize_, false, outlineThickness_);
+        }
+    }
+}
+
+// Writes the fill and outline quads of one character at its pen position, whitespace gets empty quads
+void HudText::updateGlyph(size_t index) {
+    auto setQuad = [&](std::array<sf::Vertex, HUD_TEXT_CAPACITY * 4>& vertices, const sf::Glyph& glyph, const sf::Color& color) {
+        // Same padding around the glyph as sf::Text uses, so smoothed edges aren't cut off
+        float padding = 1.f;
+        float x = penPositions_[index];
+        float y = static_cast<float>(characterSize_);
+        float left = x + glyph.bounds.left - padding;
+        float top = y + glyph.bounds.top - padding;
+        float right = x + glyph.bounds.left + glyph.bounds.width + padding;
+        float bottom = y + glyph.bounds.top + glyph.bounds.height + padding;
+        float u1 = glyph.textureRect.left - padding;
+        float v1 = glyph.textureRect.top - padding;
+        float u2 = glyph.textureRect.left + glyph.textureRect.width + padding;
+        float v2 = glyph.textureRect.top + glyph.textureRect.height + padding;
+        sf::Vertex* quad = &vertices[index * 4];
+        quad[0] = sf::Vertex(sf::Vector2f(left, top), color, sf::Vector2f(u1, v1));
+        quad[1] = sf::Vertex(sf::Vector2f(right, top), color, sf::Vector2f(u2, v1));
+        quad[2] = sf::Vertex(sf::Vector2f(right, bottom), color, sf::Vector2f(u2, v2));
+        quad[3] = sf::Vertex(sf::Vector2f(left, bottom), color, sf::Vector2f(u1, v2));
+    };
+    if (isWhitespace(text_[index])) {
+        for (size_t i = index * 4; i < index * 4 + 4; i++) {
+            fillVertices_[i] = sf::Vertex(sf::Vector2f(penPositions_[index], 0), sf::Color::Transparent);
+            outlineVertices_[i] = fillVertices_[i];
+        }
+        return;
+    }
+    sf::Uint32 character = toCodePoint(text_[index]);
+    setQuad(fillVertices_, font_->getGlyph(character, characterSize_, false), fillColor_);
+    if (outlineThickness_ != 0) {
+        setQuad(outlineVertices_, font_->getGlyph(character, characterSize_, false, outlineThickness_), outlineColor_);
+    }
+}
+
+// Lays out every character again, used when the font or the colors change
+void HudText::rebuild() {
+    if (font_ == nullptr) {
+        return;
+    }
+    float x = 0.f;
+    sf::Uint32 previous = 0;
+    for (size_t i = 0; i < length_; i++) {
+        sf::Uint32 current = toCodePoint(text_[i]);
+        x += font_->getKerning(previous, current, characterSize_);
+        penPositions_[i] = x;
+        updateGlyph(i);
+        x += getAdvance(text_[i]);
+        previous = current;
+    }
+    updateBounds();
+}
+
+float HudText::getAdvance(char character) const {
+    sf::Uint32 codePoint = isWhitespace(character) ? L' ' : toCodePoint(character);
+    return font_->getGlyph(codePoint, characterSize_, false).advance;
+}
+
+void HudText::updateBounds() {
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < length_; i++) {
+        if (isWhitespace(text_[i])) {
+            continue;
+        }
+        const sf::Glyph& glyph = font_->getGlyph(toCodePoint(text_[i]), characterSize_, false);
+        float x = penPositions_[i] + glyph.bounds.left;
+        float y = characterSize_ + glyph.bounds.top;
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x + glyph.bounds.width);
+        maxY = std::max(maxY, y + glyph.bounds.height);
+    }
+    bounds_ = minX <= maxX ? sf::FloatRect(minX, minY, maxX - minX, maxY - minY) : sf::FloatRect();
+}
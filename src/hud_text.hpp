@@ -0,0 +1,58 @@
+#ifndef HUD_TEXT_HPP
+#define HUD_TEXT_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <cstdio>
+#include "render_queue.hpp"
+
+// Longest text a HUD text can show, longer texts are truncated
+const size_t HUD_TEXT_CAPACITY = 64;
+// Characters the HUD numbers are built from, their glyphs are loaded when the font is set
+const char HUD_TEXT_DIGITS[] = "0123456789 .,:%-";
+
+/**
+ * @brief Single line label or number for the HUD that doesn't allocate when it changes
+ *
+ * The text is formatted into a fixed buffer and its glyph quads are kept in fixed arrays.
+ * When the text changes only the quads of the changed characters are rebuilt.
+ * Glyphs of the digits and of every text that has been shown are loaded into the font's cache up front,
+ * so showing a new number later doesn't grow the font's glyph pages.
+ */
+class HudText : public sf::Transformable {
+    public:
+        HudText();
+        void setFont(const sf::Font& font, unsigned int characterSize);
+        void setFillColor(const sf::Color& color);
+        void setOutline(const sf::Color& color, float thickness);
+        void setText(const char* text);
+        template <typename... Args>
+        void format(const char* format, Args... args) {
+            std::array<char, HUD_TEXT_CAPACITY + 1> buffer;
+            std::snprintf(buffer.data(), buffer.size(), format, args...);
+            setText(buffer.data());
+        }
+        const char* getText() const;
+        sf::FloatRect getLocalBounds() const;
+        sf::FloatRect getGlobalBounds() const;
+        void draw(RenderQueue& window) const;
+    private:
+        const sf::Font* font_ = nullptr;
+        unsigned int characterSize_ = 30;
+        sf::Color fillColor_ = sf::Color::White;
+        sf::Color outlineColor_ = sf::Color::Black;
+        float outlineThickness_ = 0;
+        std::array<char, HUD_TEXT_CAPACITY + 1> text_; // Null terminated
+        size_t length_ = 0;
+        std::array<float, HUD_TEXT_CAPACITY> penPositions_; // Horizontal pen position of each character
+        std::array<sf::Vertex, HUD_TEXT_CAPACITY * 4> fillVertices_;
+        std::array<sf::Vertex, HUD_TEXT_CAPACITY * 4> outlineVertices_;
+        sf::FloatRect bounds_;
+        void warmGlyphs(const char* characters) const;
+        float getAdvance(char character) const;
+        void updateGlyph(size_t index);
+        void updateBounds();
+        void rebuild();
+};
+
+#endif // HUD_TEXT_HPP
@@ -0,0 +1,118 @@
+#include "impact_listener.hpp"
+#include "utils.hpp"
+#include <algorithm>
+
+ImpactListener::ImpactListener(SpscQueue<ImpactEvent, 256>& impacts) : impacts_(impacts) {}
+
+void ImpactListener::BeginContact(b2Contact* contact) {
+    if (begunCount_ < IMPACT_CONTACT_CAPACITY) {
+        begunContacts_[begunCount_++] = contact;
+    }
+}
+
+// A contact can begin and end in the same step, its pointer may be reused by a new contact
+void ImpactListener::EndContact(b2Contact* contact) {
+    takeBegunContact(contact);
+}
+
+// Only the first solve of a contact is an impact, later ones are the objects resting on each other
+void ImpactListener::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) {
+    if (!takeBegunContact(contact)) {
+        return;
+    }
+    float strength = 0;
+    for (int i = 0; i < impulse->count; i++) {
+        strength = std::max(strength, impulse->normalImpulses[i]);
+    }
+    if (strength < IMPACT_MIN_IMPULSE) {
+        return;
+    }
+    const Object* objectA = reinterpret_cast<const Object*>(contact->GetFixtureA()->GetUserData().pointer);
+    const Object* objectB = reinterpret_cast<const Object*>(contact->GetFixtureB()->GetUserData().pointer);
+    char type = getImpactSound(objectA, objectB);
+    if (type == 0) {
+        return;
+    }
+    b2WorldManifold manifold;
+    contact->GetWorldManifold(&manifold);
+    addImpact(type, manifold.points[0], strength);
+}
+
+// Sends the strongest impacts of the step to the main thread, called after each step
+void ImpactListener::flush() {
+    for (size_t i = 0; i < strongestCount_; i++) {
+        impacts_.push(strongest_[i]);
+    }
+    strongestCount_ = 0;
+    begunCount_ = 0;
+}
+
+void ImpactListener::clear() {
+    strongestCount_ = 0;
+    begunCount_ = 0;
+}
+
+bool ImpactListener::takeBegunContact(const b2Contact* contact) {
+    for (size_t i = 0; i < begunCount_; i++) {
+        if (begunContacts_[i] == contact) {
+            begunContacts_[i] = begunContacts_[--begunCount_];
+            return true;
+        }
+    }
+    return false;
+}
+
+// A pig sounds over a bird and a bird over a wall, the ground only makes the other object sound
+char ImpactListener::getImpactSound(const Object* objectA, const Object* objectB) {
+    auto getPriority = [](const Object* object) {
+        if (object == nullptr) {
+            return 0; // Wall fragment
+        }
+        switch (object->getType()) {
+            case Object::Type::Pig:
+                return 3;
+            case Object::Type::Bird:
+            case Object::Type::MiniBird:
+                return 2;
+            case Object::Type::Wall:
+                return 1;
+            default:
+                return 0;
+        }
+    };
+    int priority = std::max(getPriority(objectA), getPriority(objectB));
+    switch (priority) {
+        case 3:
+            return 'P';
+        case 2:
+            return 'B';
+        case 1:
+            return 'W';
+        default:
+            return 0;
+    }
+}
+
+// Keeps the strongest impacts of the step, an impact next to one of the same sound is merged into it
+void ImpactListener::addImpact(char type, const b2Vec2& position, float impulse) {
+    size_t weakest = 0;
+    for (size_t i = 0; i < strongestCount_; i++) {
+        if (strongest_[i].type == type && b2DistanceSquared(strongestPositions_[i], position) < IMPACT_MERGE_DISTANCE * IMPACT_MERGE_DISTANCE) {
+            strongest_[i].impulse = std::max(strongest_[i].impulse, impulse);
+            return;
+        }
+        if (strongest_[i].impulse < strongest_[weakest].impulse) {
+            weakest = i;
+        }
+    }
+    size_t index = strongestCount_;
+    if (strongestCount_ < IMPACT_EVENTS_PER_TICK) {
+        strongestCount_++;
+    } else if (impulse > strongest_[weakest].impulse) {
+        index = weakest;
+    } else {
+        return;
+    }
+    strongest_[index] = {type, utils::B2ToSfCoords(position), impulse};
+    strongestPositions_[index] = position;
+}
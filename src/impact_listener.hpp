@@ -0,0 +1,42 @@
+#ifndef IMPACT_LISTENER_HPP
+#define IMPACT_LISTENER_HPP
+
+#include <box2d/box2d.h>
+#include <array>
+#include "object.hpp"
+#include "spsc_queue.hpp"
+#include "world_snapshot.hpp"
+
+const size_t IMPACT_CONTACT_CAPACITY = 64; // Contacts begun in one step whose impulse is measured, the rest of a collapse is silent
+const size_t IMPACT_EVENTS_PER_TICK = 4; // Strongest impacts of a step sent to the main thread
+const float IMPACT_MIN_IMPULSE = 0.5f; // Weaker impacts make no sound
+const float IMPACT_MERGE_DISTANCE = 0.5f; // Impacts of the same sound closer than this in Box2D units are merged into one
+
+/**
+ * @brief Collects the impacts of each physics step for the impact sounds
+ *
+ * Contacts that begin during a step are remembered, and their impulse is read when Box2D has solved them.
+ * Near-identical impacts are merged and only the strongest IMPACT_EVENTS_PER_TICK of a step are sent to the main thread,
+ * so a collapsing structure costs the same as a single hit. Used by the physics thread.
+ */
+class ImpactListener : public b2ContactListener {
+    public:
+        ImpactListener(SpscQueue<ImpactEvent, 256>& impacts);
+        void BeginContact(b2Contact* contact) override;
+        void EndContact(b2Contact* contact) override;
+        void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
+        void flush();
+        void clear();
+    private:
+        SpscQueue<ImpactEvent, 256>& impacts_;
+        std::array<b2Contact*, IMPACT_CONTACT_CAPACITY> begunContacts_ = {};
+        size_t begunCount_ = 0;
+        std::array<ImpactEvent, IMPACT_EVENTS_PER_TICK> strongest_;
+        std::array<b2Vec2, IMPACT_EVENTS_PER_TICK> strongestPositions_; // Box2D positions of the strongest impacts for merging
+        size_t strongestCount_ = 0;
+        bool takeBegunContact(const b2Contact* contact);
+        static char getImpactSound(const Object* objectA, const Object* objectB);
+        void addImpact(char type, const b2Vec2& position, float impulse);
+};
+
+#endif // IMPACT_LISTENER_HPP
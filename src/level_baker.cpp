@@ -0,0 +1,34 @@
+#include "level_baker.hpp"
+#include "level_simulation.hpp"
+
+LevelBaker::LevelBaker(float maxSeconds) : maxSeconds_(maxSeconds) {}
+
+bool LevelBaker::bake(json& levelJson) const {
+    LevelSimulation simulation(levelJson);
+    simulation.wakeAll();
+    while (!simulation.isAsleep() && simulation.getElapsedTime() < maxSeconds_) {
+        simulation.step();
+    }
+    if (!simulation.isAsleep()) {
+        return false;
+    }
+    for (const auto& object : simulation.getObjects()) {
+        if (object.isRemoved()) {
+            return false; // Level is not stable, keep the editor positions
+        }
+    }
+    json& objects = levelJson["objects"];
+    for (const auto& object : simulation.getObjects()) {
+        if (object.type == Object::Type::Ground) {
+            continue;
+        }
+        json& body = objects[object.index]["body"];
+        b2Vec2 position = object.body->GetPosition();
+        body["position"] = {position.x, position.y};
+        body["angle"] = object.body->GetAngle();
+        body["linearVelocity"] = {0.f, 0.f};
+        body["angularVelocity"] = 0.f;
+        body["awake"] = false;
+    }
+    return true;
+}
@@ -0,0 +1,22 @@
+#ifndef LEVEL_BAKER_HPP
+#define LEVEL_BAKER_HPP
+
+#include "level_loader.hpp"
+
+/**
+ * @brief Settles a level before it is saved
+ *
+ * The level is simulated headlessly until every body sleeps and the settled transforms are written back
+ * to the level json with zero velocities and awake set to false. The level then starts with an asleep world
+ * instead of spending its first seconds settling stacks in game.
+ * Levels that lose objects or don't come to rest within the time limit are left unchanged.
+ */
+class LevelBaker {
+    public:
+        LevelBaker(float maxSeconds = 10.f);
+        bool bake(json& levelJson) const;
+    private:
+        float maxSeconds_; // Maximum simulated seconds to wait for the level to sleep
+};
+
+#endif // LEVEL_BAKER_HPP
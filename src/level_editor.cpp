@@ -1,5 +1,6 @@
 #include "level_editor.hpp"
 #include "utils.hpp"
+#include "game_view.hpp"
 
 // half width and half height of the wall
 sf::Vector2f WALL_INITIAL_SF_DIM(25, 150);
@@ -24,31 +25,10 @@ LevelEditor::LevelEditor() : levelCreator_() {
     cannon_.init();
     // Initialize notifications
     notifications_.init();
-    // Add background
-    int height = VIEW.getHeight();
-    sf::Texture& backgroundImage = ResourceManager::getInstance().getTexture("/assets/images/background2.jpg");
-    auto size = backgroundImage.getSize();
-    auto scaleFactor = utils::getScaleFactor(size.x, size.y, VIEW.getWidth() * 2.f, height * 1.8f);
-    background_.setSize(sf::Vector2f(size.x * scaleFactor, size.y * scaleFactor));
-    background_.setTexture(&backgroundImage);
-    background_.setPosition(0,-height+ 200);
 }
 
 void LevelEditor::handleResize() {
-    // Original dimensions of the background image
-    float originalWidth = WORLD_WIDTH;
-    float originalHeight = WORLD_HEIGHT;
-
-    // Calculate the scale factors based on the new window size
-    float scaleX = (2 * VIEW.getWidth()) / originalWidth;
-    float scaleY = (1.8f * VIEW.getHeight()) / originalHeight;
-
-    // Choose the smaller of the two scale factors
-    float scaleFactor = std::min(scaleX, scaleY);
-
-    // Apply the scaling to the background (this scales both axes proportionally)
-    background_.setScale(scaleFactor, scaleFactor);
-    background_.setPosition(0, -VIEW.getHeight() + 200);
+    background_.handleResize();
 
     cannon_.handleResize();
     buttonGroups_.handleResize();
@@ -67,9 +47,10 @@ void LevelEditor::handleResize() {
 }
 
 
-void LevelEditor::draw(sf::RenderWindow& window) const {
+void LevelEditor::draw(RenderQueue& window) const {
     // Draw background
-    window.draw(background_);
+    background_.draw(window);
+    background_.drawBase(window);
     // Draw ground
     window.draw(ground_.sprite);
     // Draw editor buttons
@@ -142,7 +123,7 @@ int LevelEditor::getItemAtPosition(const sf::Vector2f& mousePosition) const {
     return -1;
 }
 
-bool LevelEditor::handleMouseClick(const sf::Vector2f& mousePosition, const sf::RenderWindow& window) {
+bool LevelEditor::handleMouseClick(const sf::Vector2f& mousePosition, GameView& view) {
     int itemIndex = getItemAtPosition(mousePosition);
     if (itemIndex >= 0) {
         selectedItem_ = itemIndex;
@@ -153,7 +134,7 @@ bool LevelEditor::handleMouseClick(const sf::Vector2f& mousePosition, const sf::
             dragOffsets_.objectDragOffset = objects_[index].sprite.getPosition() - mousePosition;
             dragOffsets_.deleteDragOffset = objects_[index].deleteButton.getPosition() - mousePosition;
         } else if (item == Item::SAVE) {
-            saveLevel(window);
+            saveLevel(view);
         } else if (item == Item::SETTINGS) {
             settings_.handleMouseClick(mousePosition);
         } else if (item == Item::DELETE_OBJECT) {
@@ -711,7 +692,7 @@ const int LevelEditor::getIconButtonIndex() const {
     return selectedItem_ - EDITOR_BUTTONS;
 }
 
-void LevelEditor::saveLevel(const sf::RenderWindow& window) {
+void LevelEditor::saveLevel(GameView& view) {
     bool noPigs = true;
     bool hasErrors = false;
     for (const auto& object : objects_) {
@@ -744,13 +725,16 @@ void LevelEditor::saveLevel(const sf::RenderWindow& window) {
         levelObjects.push_back(object);
     }
     
-    levelCreator_.createLevel(birdList_, levelObjects);
-    levelCreator_.captureScreenShot(window);
+    bool isBaked = levelCreator_.createLevel(birdList_, levelObjects);
+    levelCreator_.captureScreenShot(view.capture());
     notifications_.addNotification("Level and screenshot saved successfully", Notifications::Type::MESSAGE);
+    if (!isBaked) {
+        notifications_.addNotification("Level did not settle, objects were saved at their editor positions", Notifications::Type::MESSAGE);
+    }
 }
 
-void LevelEditor::captureLevelImage(const sf::RenderWindow& window) {
-    levelCreator_.captureScreenShot(window);
+void LevelEditor::captureLevelImage(GameView& view) {
+    levelCreator_.captureScreenShot(view.capture());
     notifications_.addNotification("Screenshot saved successfully", Notifications::Type::MESSAGE);
 }
 
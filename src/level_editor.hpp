@@ -4,8 +4,12 @@
 #include <SFML/Graphics.hpp>
 #include "level_loader.hpp"
 #include "cannon.hpp"
+#include "parallax_background.hpp"
 #include <unordered_set>
 
+// Forward declare GameView
+class GameView;
+
 // Constants
 const int EDITOR_BUTTONS = 5;
 const int ICON_BUTTONS = 2;
@@ -196,7 +200,7 @@ struct Notifications {
         height = 40;
         currentType = Type::EMPTY;
     }
-    void draw(sf::RenderWindow& window) const {
+    void draw(RenderQueue& window) const {
         if (Type::EMPTY != currentType) {
             window.draw(background);
             if (Type::ERROR_MESSAGE == currentType) {
@@ -400,7 +404,7 @@ struct CheckboxGroup {
     bool isHovered(const sf::Vector2f& mousePosition) const {
         return isOpen && background.getGlobalBounds().contains(mousePosition);
     }
-    void draw(sf::RenderWindow& window) const {
+    void draw(RenderQueue& window) const {
         if (isOpen) {
             window.draw(background);
             for (const auto& checkboxPair : checkBoxes) {
@@ -500,9 +504,9 @@ class LevelEditor {
             UNDEFINED
         };
         LevelEditor();
-        void draw(sf::RenderWindow& window) const;
+        void draw(RenderQueue& window) const;
         int getItemAtPosition(const sf::Vector2f& mousePosition) const;
-        bool handleMouseClick(const sf::Vector2f& mousePosition, const sf::RenderWindow& window);
+        bool handleMouseClick(const sf::Vector2f& mousePosition, GameView& view);
         void handleKeyPress(const sf::Keyboard::Key& key);
         void handleKeyRelease();
         void handleMouseMove(const sf::Vector2f& mousePosition);
@@ -512,8 +516,8 @@ class LevelEditor {
         void createObject();
         Item convertIndexToItem() const;
         bool isDragging() const;
-        void saveLevel(const sf::RenderWindow& window);
-        void captureLevelImage(const sf::RenderWindow& window);
+        void saveLevel(GameView& view);
+        void captureLevelImage(GameView& view);
         void update();
         void updateHUD(const sf::RenderWindow& window);
     private:
@@ -525,7 +529,7 @@ class LevelEditor {
         std::vector<LevelObject> objects_;
         std::vector<Bird::Type> birdList_;
         ButtonGroup buttonGroups_;
-        sf::RectangleShape background_;
+        ParallaxBackground background_;
         int selectedItem_ = 0;
         bool isDragging_ = false;
         bool isPressed_ = false;
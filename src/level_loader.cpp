@@ -2,6 +2,9 @@
 #include "utils.hpp"
 #include "world.hpp"
 #include "resource_manager.hpp"
+#include "level_baker.hpp"
+#include "trace.hpp"
+#include "collision_filter.hpp"
 
 // half width and half height of the wall
 b2Vec2 WALL_DIMENSONS = utils::SfToB2(sf::Vector2f(25.f, 150.f));
@@ -84,6 +87,10 @@ void from_json(const json& j, ObjectData& data) {
             data.type = Object::Type::Ground;
             data.bodyType = j.at("bodyType").get_to(data.bodyType);
             data.position = b2Vec2(GROUND_DIMENSIONS.x, 0);
+            // Ground of a level chunk is placed under the chunk
+            if (j.contains("position")) {
+                j.at("position").get_to(data.position);
+            }
             return;
         case 'P':
             data.type = Object::Type::Pig;
@@ -105,10 +112,35 @@ void from_json(const json& j, ObjectData& data) {
     j.at("awake").get_to(data.awake);
 }
 
+void from_json(const json& j, ChunkInfo& info) {
+    j.at("file").get_to(info.file);
+    info.pigCount = j.value("pigs", 0);
+}
+
+void from_json(const json& j, ChunkIndex& index) {
+    j.at("width").get_to(index.width);
+    j.at("list").get_to(index.chunks);
+    if (index.width <= 0) {
+        throw std::runtime_error("Chunk width should be positive");
+    }
+}
+
+float ChunkIndex::getWorldWidth() const {
+    return std::max(static_cast<float>(WORLD_WIDTH), utils::B2ToSf(width * chunks.size()));
+}
+
 
 LevelLoader::LevelLoader(World& world) : level_(world) {}
 
 
+// ResourceManager is only used by the main thread, the textures are looked up before any object of the level is created
+void LevelLoader::resolveTextures() {
+    ResourceManager& resourceManager = ResourceManager::getInstance();
+    groundTexture_ = &resourceManager.getTexture(GROUND_TEXTURE);
+    pigTexture_ = &resourceManager.getTexture(PIG_TEXTURE);
+    wallTexture_ = &resourceManager.getTexture(WALL_TEXTURE);
+}
+
 void LevelLoader::setLevelName(json levelJson) {
     level_.levelIndex_ = levelJson["id"];
     level_.levelName_ = "Level " + std::to_string(level_.levelIndex_ + 1);
@@ -125,14 +157,16 @@ std::vector<Bird::Type> LevelLoader::readBirdList(json levelJson) {
             birdList.push_back(Bird::Type::Blue);
         } else if (birdType == "G") {
             birdList.push_back(Bird::Type::Green);
+        } else if (birdType == "X") {
+            birdList.push_back(Bird::Type::Explosive);
         } else {
-            throw std::runtime_error("Invalid bird type. Should be one of R, L, G");
+            throw std::runtime_error("Invalid bird type. Should be one of R, L, G, X");
         }
     }
     return birdList;
 }
 
-b2Body* LevelLoader::createBody(const ObjectData& data) {
+b2BodyDef LevelLoader::createBodyDef(const ObjectData& data) {
     b2BodyDef body_def;
     switch (data.type) {
         case Object::Type::Bird:
@@ -152,7 +186,11 @@ b2Body* LevelLoader::createBody(const ObjectData& data) {
             body_def.position = data.position;
             body_def.type = data.bodyType;
     }
+    return body_def;
+}
 
+b2Body* LevelLoader::createBody(const ObjectData& data) {
+    b2BodyDef body_def = createBodyDef(data);
     b2Body *body = level_.world_->CreateBody(&body_def);
 
     return body;
@@ -178,6 +216,7 @@ void LevelLoader::createFixtureShape(ShapeData data, b2FixtureDef& fixtureDef, O
             throw std::runtime_error("Unknown shape type");
     }
     // Read the rest of the fixture data, density, friction, restitution
+    fixtureDef.filter = getCollisionFilter(type);
     fixtureDef.friction = data.friction;
     fixtureDef.restitution = data.restitution;
     if (type == Object::Type::Ground) {
@@ -199,8 +238,11 @@ void LevelLoader::createBird(Bird::Type birdType, b2Body* body, b2FixtureDef& fi
         case Bird::Type::Green:
             bird = new GreenBird(body, fixtureDef.shape->m_radius);
             break;
+        case Bird::Type::Explosive:
+            bird = new ExplosiveBird(body, fixtureDef.shape->m_radius);
+            break;
         default:
-            throw std::runtime_error("Invalid bird type, bird type is one of R, L, G");
+            throw std::runtime_error("Invalid bird type, bird type is one of R, L, G, X");
     }
     if (bird) {
         level_.addObject(bird);
@@ -210,7 +252,7 @@ void LevelLoader::createBird(Bird::Type birdType, b2Body* body, b2FixtureDef& fi
     }
 }
 
-void LevelLoader::createObject(
+Object* LevelLoader::createObject(
     Object::Type objType,
     b2Body* body,
     b2FixtureDef& fixtureDef,
@@ -222,15 +264,15 @@ void LevelLoader::createObject(
             // Bird is created with createBird function
             break;
         case Object::Type::Ground:
-            object = new Ground(body, shapeData.dimensions.x, shapeData.dimensions.y);
+            object = new Ground(body, shapeData.dimensions.x, shapeData.dimensions.y, *groundTexture_);
             fixtureDef.userData.pointer = reinterpret_cast<uintptr_t>(object);
             break;
         case Object::Type::Pig:
-            object = new Pig(body, fixtureDef.shape->m_radius);
+            object = new Pig(body, fixtureDef.shape->m_radius, *pigTexture_);
             fixtureDef.userData.pointer = reinterpret_cast<uintptr_t>(object);
             break;
         case Object::Type::Wall:
-            object = new Wall(body, shapeData.dimensions.x, shapeData.dimensions.y);
+            object = new Wall(body, shapeData.dimensions.x, shapeData.dimensions.y, *wallTexture_);
             fixtureDef.userData.pointer = reinterpret_cast<uintptr_t>(object);
             break;
         default:
@@ -239,9 +281,53 @@ void LevelLoader::createObject(
     if (object) {
         level_.addObject(object);
     }
+    return object;
+}
+
+// Creates the Box2D body and fixture of a level or chunk object and adds the object to the World
+Object* LevelLoader::loadObject(ObjectData data, const ShapeData& shapeData) {
+    b2Body *body = createBody(data);
+    b2FixtureDef fixtureDef;
+    Shapes shapes;
+    createFixtureShape(shapeData, fixtureDef, data.type, shapes);
+    Object* object = createObject(data.type, body, fixtureDef, shapeData);
+    body->CreateFixture(&fixtureDef);
+    return object;
+}
+
+// Returns an empty index for levels without chunks
+ChunkIndex LevelLoader::readChunkIndex(const json& levelJson) {
+    ChunkIndex index;
+    if (levelJson.contains("chunks")) {
+        levelJson.at("chunks").get_to(index);
+    }
+    return index;
+}
+
+// Reads the objects of a chunk file, called by the chunk loader thread
+std::vector<ChunkObject> LevelLoader::readChunkFile(const std::string& path) {
+    TRACE_ZONE("LevelLoader::readChunkFile");
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    json chunkJson;
+    file >> chunkJson;
+    std::vector<ChunkObject> objects;
+    for (const auto& obj : chunkJson.at("objects")) {
+        ChunkObject object;
+        obj.at("body").get_to(object.data);
+        obj.at("shape").get_to(object.shapeData);
+        if (object.data.type == Object::Type::Bird) {
+            throw std::runtime_error("Chunks can't contain birds: " + path);
+        }
+        objects.push_back(object);
+    }
+    return objects;
 }
 
 void LevelLoader::saveHighScores(const std::vector<HighScore> &highScores, const std::string& fileName) {
+    TRACE_ZONE("LevelLoader::saveHighScores");
     std::string path = utils::getExecutablePath() + "/assets/levels/";
     std::ifstream inFile(path + fileName);
     if(!inFile.is_open()) {
@@ -273,18 +359,17 @@ void LevelLoader::loadSfmlObjects(std::vector<Bird::Type>& birdList) {
     // create pig sprite and text
     int offset = level_.cannon_->getTextWidth() + 40;
     SfObject pigObject;
-    sf::Texture& pig = resourceManager.getTexture("/assets/images/pig.png");
+    sf::Texture& pig = resourceManager.getTexture(PIG_TEXTURE);
     sf::Sprite pigSprite;
     pigSprite.setTexture(pig);
-    pigSprite.setScale(0.09f, 0.09f);
+    float pigScale = HUD_PIG_ICON_WIDTH / pig.getSize().x;
+    pigSprite.setScale(pigScale, pigScale);
     pigSprite.setPosition(offset, 10);
-    sf::Text pigText;
-    pigText.setFont(font);
-    pigText.setCharacterSize(40);
+    HudText pigText;
+    pigText.setFont(font, 40);
     pigText.setFillColor(sf::Color::White);
-    pigText.setOutlineColor(sf::Color::Black);
-    pigText.setOutlineThickness(2);
-    pigText.setString(std::to_string(level_.totalPigCount_));
+    pigText.setOutline(sf::Color::Black, 2);
+    pigText.format("%d", level_.totalPigCount_);
     sf::FloatRect pigBounds = pigSprite.getLocalBounds();
     pigText.setPosition(offset + 20,45);
     // set the pig object
@@ -295,7 +380,7 @@ void LevelLoader::loadSfmlObjects(std::vector<Bird::Type>& birdList) {
     // add the pig object to the list
     sfObjects.push_back(pigObject);
     // get the bird counts
-    std::vector<int> birdsLeft = {0,0,0};
+    std::vector<int> birdsLeft = {0,0,0,0};
     for(auto bird : birdList) {
         switch (bird)
         {
@@ -308,6 +393,9 @@ void LevelLoader::loadSfmlObjects(std::vector<Bird::Type>& birdList) {
         case Bird::Type::Green:
             birdsLeft[2]++;
             break;
+        case Bird::Type::Explosive:
+            birdsLeft[3]++;
+            break;
         default:
             break;
         }
@@ -321,13 +409,15 @@ void LevelLoader::loadSfmlObjects(std::vector<Bird::Type>& birdList) {
                 return "/assets/images/blue_bird.png";
             case 2:
                 return "/assets/images/green_bird.png";
+            case 3:
+                return "/assets/images/red_bird.png";
             default:
                 return "";
         }
     };
     // create bird sprites and texts
     offset += 60;
-    for(int i = 0; i < 3; i++) {
+    for(int i = 0; i < 4; i++) {
         int count = birdsLeft[i];
         if (count == 0) {
             continue;
@@ -335,22 +425,24 @@ void LevelLoader::loadSfmlObjects(std::vector<Bird::Type>& birdList) {
         sf::Texture& bird = resourceManager.getTexture(getFilePath(i));
         sf::Sprite birdSprite;
         birdSprite.setTexture(bird);
-        birdSprite.setScale(0.1f, 0.1f);
+        float birdScale = HUD_BIRD_ICON_WIDTH / bird.getSize().x;
+        birdSprite.setScale(birdScale, birdScale);
         birdSprite.setPosition(offset, 10);
-        sf::Text birdText;
-        birdText.setFont(font);
-        birdText.setCharacterSize(40);
+        if (i == 3) {
+            birdSprite.setColor(EXPLOSIVE_BIRD_COLOR);
+        }
+        HudText birdText;
+        birdText.setFont(font, 40);
         birdText.setFillColor(sf::Color::White);
-        birdText.setOutlineColor(sf::Color::Black);
-        birdText.setOutlineThickness(2);
-        birdText.setString(std::to_string(count));
+        birdText.setOutline(sf::Color::Black, 2);
+        birdText.format("%d", count);
         birdText.setPosition(offset + 20, 45);
         offset += 60;
         // set the bird object
         SfObject birdObject;
         birdObject.sprite = birdSprite;
         birdObject.text = birdText;
-        birdObject.type = i == 0 ? 'R' : i == 1 ? 'L' : 'G';
+        birdObject.type = i == 0 ? 'R' : i == 1 ? 'L' : i == 2 ? 'G' : 'X';
         birdObject.count = count;
         // add the bird object to the list
         sfObjects.push_back(birdObject);
@@ -360,6 +452,7 @@ void LevelLoader::loadSfmlObjects(std::vector<Bird::Type>& birdList) {
 }
 
 void LevelLoader::loadLevel(const std::string& fileName) {
+    TRACE_ZONE("LevelLoader::loadLevel");
     std::string path = utils::getExecutablePath() + "/assets/levels/";
     std::ifstream file(path + fileName);
     if(!file.is_open()) {
@@ -369,6 +462,7 @@ void LevelLoader::loadLevel(const std::string& fileName) {
     json levelJson;
     file >> levelJson;
     file.close();
+    resolveTextures();
     // Read and set level name and file name
     setLevelName(levelJson);
     level_.fileName_ = fileName;
@@ -407,17 +501,14 @@ void LevelLoader::loadLevel(const std::string& fileName) {
 
     // Read objects and create Box2D bodies and fixtures
     for (const auto& obj : levelJson["objects"]) {
-        auto jsonBody = obj["body"];
-        auto jsonShape = obj["shape"];
-        ObjectData data = jsonBody.template get<ObjectData>();
-        b2Body *body = createBody(data);
-        b2FixtureDef fixtureDef;
-        Shapes shapes;
-        ShapeData shapeData = jsonShape.template get<ShapeData>();
-        createFixtureShape(shapeData, fixtureDef, data.type, shapes);
-        createObject(data.type, body, fixtureDef, shapeData);
-        body->CreateFixture(&fixtureDef);
+        ObjectData data = obj["body"].template get<ObjectData>();
+        ShapeData shapeData = obj["shape"].template get<ShapeData>();
+        loadObject(data, shapeData);
     }
+    // Chunks are created by the World as they come into range, pigs of the chunks count as remaining until then
+    ChunkIndex chunkIndex = readChunkIndex(levelJson);
+    utils::setWorldWidth(chunkIndex.getWorldWidth());
+    level_.chunks_.setIndex(chunkIndex);
     // Set the total bird and pig count
     level_.totalBirdCount_ = level_.getRemainingBirdCount();
     level_.totalPigCount_ = level_.getRemainingPigCount();
@@ -429,7 +520,7 @@ void LevelLoader::loadLevel(const std::string& fileName) {
 // LevelCreator class implementation
 LevelCreator::LevelCreator() {}
 
-void LevelCreator::createLevel(const std::vector<Bird::Type>& birdList, const std::vector<LevelObject>& objects) const {
+bool LevelCreator::createLevel(const std::vector<Bird::Type>& birdList, const std::vector<LevelObject>& objects) const {
     int levelCount = utils::countFilesInDirectory();
     std::string fileName = "level" + std::to_string(levelCount + 1) + ".json";
     std::string path = utils::getExecutablePath() + "/assets/levels/";
@@ -442,8 +533,10 @@ void LevelCreator::createLevel(const std::vector<Bird::Type>& birdList, const st
     levelJson["highScores"] = json::array();
     levelJson["birds"] = createBirds(birdList);
     levelJson["objects"] = createObjects(objects);
+    bool isBaked = LevelBaker().bake(levelJson);
     file << levelJson.dump(4);
     file.close();
+    return isBaked;
 }
 
 json LevelCreator::createBirdObject() const {
@@ -482,8 +575,10 @@ json LevelCreator::createBirds(const std::vector<Bird::Type>& birdList) const {
             birdsArray.push_back("L");
         } else if (bird == Bird::Type::Green) {
             birdsArray.push_back("G");
+        } else if (bird == Bird::Type::Explosive) {
+            birdsArray.push_back("X");
         } else {
-            throw std::runtime_error("Invalid bird type. Should be one of R, L, G");
+            throw std::runtime_error("Invalid bird type. Should be one of R, L, G, X");
         }
     }
     birdsJson["list"] = birdsArray;
@@ -502,11 +597,8 @@ json LevelCreator::createObjects(const std::vector<LevelObject>& objects) const
     return objectsArray;
 }
 
-void LevelCreator::captureScreenShot(const sf::RenderWindow& window) const {
-    sf::Texture texture;
-    texture.create(window.getSize().x, window.getSize().y);
-    texture.update(window);
-    sf::Image image = texture.copyToImage();
+void LevelCreator::captureScreenShot(const sf::Image& image) const {
+    TRACE_ZONE("LevelCreator::captureScreenShot");
     std::string path = utils::getExecutablePath() + "/assets/screenshots/";
     std::string fileName = "level" + std::to_string(utils::countFilesInDirectory()) + ".png";
     image.saveToFile(path + fileName);
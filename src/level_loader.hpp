@@ -16,6 +16,10 @@ using json = nlohmann::json;
 // Forward declare World class
 class World;
 
+// HUD icons are sized on screen, so they don't depend on the import size of the textures
+const float HUD_PIG_ICON_WIDTH = 57.6f; // Pixels
+const float HUD_BIRD_ICON_WIDTH = 51.2f; // Pixels
+
 struct ShapeData {
     int shapeType; // 0: Circle, 1: Polygon
     b2Vec2 shapePosition; // Position of the shape
@@ -39,6 +43,49 @@ struct ObjectData {
     bool awake; // Whether the object is awake
 };
 
+/**
+ * @brief Object of a level chunk, read by the chunk loader thread and created when the chunk comes into range
+ *
+ * @param data The body data of the object
+ * @param shapeData The shape data of the object
+ */
+struct ChunkObject {
+    ObjectData data;
+    ShapeData shapeData;
+};
+
+/**
+ * @brief Entry of the chunk index of a level wider than WORLD_WIDTH
+ *
+ * @param file Path of the chunk file relative to assets/levels
+ * @param pigCount Number of pigs in the chunk, counted as remaining before the chunk is loaded
+ */
+struct ChunkInfo {
+    std::string file;
+    int pigCount = 0;
+};
+
+/**
+ * @brief Chunk index of a level, chunk i covers x from i * width to (i + 1) * width in Box2D units
+ *
+ * @param width Width of each chunk in Box2D units
+ * @param chunks The chunks from left to right, empty for levels that fit into WORLD_WIDTH
+ */
+struct ChunkIndex {
+    float width = 0;
+    std::vector<ChunkInfo> chunks;
+    float getWorldWidth() const; // In pixels, at least WORLD_WIDTH
+};
+
+// Json conversions for the level file data, defined in level_loader.cpp
+void from_json(const json& j, b2Vec2& vec);
+void to_json(json& j, const ShapeData& data);
+void from_json(const json& j, ShapeData& data);
+void to_json(json& j, const ObjectData& data);
+void from_json(const json& j, ObjectData& data);
+void from_json(const json& j, ChunkInfo& info);
+void from_json(const json& j, ChunkIndex& index);
+
 // Define the shapes of the objects
 struct Shapes {
     b2CircleShape circle;
@@ -75,23 +122,35 @@ class LevelLoader {
         LevelLoader(World& level);
         void loadLevel(const std::string& fileName);
         void saveHighScores(const std::vector<HighScore> &highScores, const std::string& fileName);
+        // Helpers shared with headless tools that build a Box2D world without a World
+        static b2BodyDef createBodyDef(const ObjectData& data);
+        static void createFixtureShape(ShapeData data, b2FixtureDef& fixtureDef, Object::Type& type, Shapes &shapes);
+        // Chunked levels, the chunk files are read without a World so the chunk loader thread can parse them
+        static ChunkIndex readChunkIndex(const json& levelJson);
+        static std::vector<ChunkObject> readChunkFile(const std::string& path);
+        Object* loadObject(ObjectData data, const ShapeData& shapeData);
     private:
         World& level_;
+        // Textures of the level objects, resolved on the main thread when a level is loaded, so chunk objects can be created on the physics thread
+        const sf::Texture* groundTexture_ = nullptr;
+        const sf::Texture* pigTexture_ = nullptr;
+        const sf::Texture* wallTexture_ = nullptr;
         // Helper functions for loading the level
         std::vector<Bird::Type> readBirdList(json levelJson); 
         b2Body* createBody(const ObjectData& data);
-        void createFixtureShape(ShapeData data, b2FixtureDef& fixtureDef, Object::Type& type, Shapes &shapes);
-        void createObject(Object::Type objType, b2Body* body, b2FixtureDef& fixtureDef, const ShapeData& shapeData);
+        Object* createObject(Object::Type objType, b2Body* body, b2FixtureDef& fixtureDef, const ShapeData& shapeData);
         void createBird(Bird::Type birdType, b2Body* body, b2FixtureDef& fixtureDef);
         void setLevelName(json levelJson);
+        void resolveTextures();
         void loadSfmlObjects(std::vector<Bird::Type>& birdList);
 };
 
 class LevelCreator {
     public:
         LevelCreator();
-        void createLevel(const std::vector<Bird::Type>& birdList, const std::vector<LevelObject>& objects) const;
-        void captureScreenShot(const sf::RenderWindow& window) const;
+        // Returns whether the level was settled before saving
+        bool createLevel(const std::vector<Bird::Type>& birdList, const std::vector<LevelObject>& objects) const;
+        void captureScreenShot(const sf::Image& image) const;
     private:
         json createBirdObject() const;
         json createBirds(const std::vector<Bird::Type>& birdList) const;
@@ -100,7 +100,7 @@ void LevelSelector::handleResize() {
     signText_[2].setPosition(sign_[1].getPosition().x, sign_[1].getPosition().y + 20);
 }
 
-void LevelSelector::draw(sf::RenderWindow& window) const {
+void LevelSelector::draw(RenderQueue& window) const {
     for (const auto& menuItem : menuItems_) {
         window.draw(menuItem);
     }
@@ -276,7 +276,7 @@ void LevelSelector::setSignTexts() {
     }
 }
 
-void LevelSelector::drawStars(sf::RenderWindow& window) const {
+void LevelSelector::drawStars(RenderQueue& window) const {
     if (auto player = player_.lock()) {
         window.draw(stars_[starIndex_]);
     }
@@ -20,7 +20,7 @@ class LevelSelector {
             UNDEFINED
         };
         LevelSelector();
-        void draw(sf::RenderWindow& window) const;
+        void draw(RenderQueue& window) const;
         const Item getSelectedItem() const;
         void setSelectedItem(Item nextItem);
         Item getItemAtPosition(const sf::Vector2f& mousePosition) const;
@@ -54,7 +54,7 @@ class LevelSelector {
         void setLevelStarIndex();
         void setLevelHighScore();
         void setSignTexts();
-        void drawStars(sf::RenderWindow& window) const;
+        void drawStars(RenderQueue& window) const;
         bool isButtonDisabled(int index) const;
         void loadLevels();
 };
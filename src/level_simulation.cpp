@@ -0,0 +1,115 @@
+#include "level_simulation.hpp"
+#include "utils.hpp"
+#include "pig.hpp"
+#include "wall.hpp"
+#include "damage_table.hpp"
+#include <cmath>
+
+LevelSimulation::LevelSimulation(const json& levelJson) : world_(b2Vec2(0.0f, -9.8f)) {
+    const json& objects = levelJson.at("objects");
+    // Fixtures point to the simulated objects, so the vector must not reallocate
+    objects_.reserve(objects.size());
+    int index = 0;
+    for (const auto& objectJson : objects) {
+        createObject(index++, objectJson);
+    }
+}
+
+void LevelSimulation::createObject(int index, const json& objectJson) {
+    ObjectData data = objectJson.at("body").get<ObjectData>();
+    ShapeData shapeData = objectJson.at("shape").get<ShapeData>();
+    if (data.type == Object::Type::Bird) {
+        throw std::runtime_error("Birds should be in the birds list, not in the objects list");
+    }
+    b2FixtureDef fixtureDef;
+    Shapes shapes;
+    LevelLoader::createFixtureShape(shapeData, fixtureDef, data.type, shapes);
+    b2BodyDef bodyDef = LevelLoader::createBodyDef(data);
+    b2Body* body = world_.CreateBody(&bodyDef);
+    float health = 0;
+    if (data.type == Object::Type::Pig) {
+        health = PIG_HEALTH;
+    } else if (data.type == Object::Type::Wall) {
+        health = WALL_HEALTH;
+    }
+    objects_.push_back({index, data.type, body, health});
+    fixtureDef.userData.pointer = reinterpret_cast<uintptr_t>(&objects_.back());
+    body->CreateFixture(&fixtureDef);
+}
+
+void LevelSimulation::step() {
+    world_.Step(TIME_STEP, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+    handleCollisions();
+    // Remove destroyed and out of bounds objects from the simulation like World::handleObjectState
+    for (auto& object : objects_) {
+        if (object.type == Object::Type::Ground || object.isRemoved()) {
+            continue;
+        }
+        object.isOutOfBounds = utils::isOutOfBounds(object.body->GetPosition());
+        if (object.isRemoved()) {
+            object.body->SetEnabled(false);
+        } else {
+            object.prevY = object.body->GetPosition().y;
+        }
+    }
+    steps_++;
+}
+
+void LevelSimulation::run(float seconds) {
+    int steps = static_cast<int>(std::ceil(seconds / TIME_STEP));
+    for (int i = 0; i < steps; i++) {
+        step();
+    }
+}
+
+// Same contact iteration as World::handleCollisions so the damage matches the game
+void LevelSimulation::handleCollisions() {
+    for (b2Contact *contact = world_.GetContactList(); contact; contact = contact->GetNext()) {
+        auto *objectA = reinterpret_cast<SimulatedObject *>(contact->GetFixtureA()->GetUserData().pointer);
+        auto *objectB = reinterpret_cast<SimulatedObject *>(contact->GetFixtureB()->GetUserData().pointer);
+        if (objectA == nullptr || objectB == nullptr) {
+            continue;
+        }
+        applyImpact(*objectA, *objectB);
+        applyImpact(*objectB, *objectA);
+    }
+}
+
+void LevelSimulation::applyImpact(SimulatedObject& object, const SimulatedObject& other) {
+    if (object.isDestroyed) {
+        return;
+    }
+    float damage = DamageTable::getInstance().getDamage(object.type, other.type, object.body, other.body, object.prevY);
+    if (damage <= 0) {
+        return;
+    }
+    // Level objects have a damage multiplier of 1
+    object.health -= damage;
+    if (object.health <= 0) {
+        object.isDestroyed = true;
+    }
+}
+
+// Levels can be saved asleep, wake them so unsupported objects still fall
+void LevelSimulation::wakeAll() {
+    for (auto& object : objects_) {
+        object.body->SetAwake(true);
+    }
+}
+
+bool LevelSimulation::isAsleep() const {
+    for (const auto& object : objects_) {
+        if (!object.isRemoved() && object.body->GetType() == b2_dynamicBody && object.body->IsAwake()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float LevelSimulation::getElapsedTime() const {
+    return steps_ * TIME_STEP;
+}
+
+const std::vector<SimulatedObject>& LevelSimulation::getObjects() const {
+    return objects_;
+}
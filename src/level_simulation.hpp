@@ -0,0 +1,59 @@
+#ifndef LEVEL_SIMULATION_HPP
+#define LEVEL_SIMULATION_HPP
+
+#include <box2d/box2d.h>
+#include <vector>
+#include "level_loader.hpp"
+
+/**
+ * @brief Body of a level object in a headless simulation
+ *
+ * @param index The index of the object in the level's objects array
+ * @param type The type of the object, Ground, Pig or Wall
+ * @param body The Box2D body of the object
+ * @param health The remaining health of the object, same starting health as in game
+ * @param prevY The y position of the body after the previous step, used for ground impacts like Object::update
+ * @param isDestroyed Whether the object has run out of health
+ * @param isOutOfBounds Whether the object has left the world
+ */
+struct SimulatedObject {
+    int index;
+    Object::Type type;
+    b2Body* body;
+    float health;
+    float prevY = 0;
+    bool isDestroyed = false;
+    bool isOutOfBounds = false;
+    bool isRemoved() const {
+        return isDestroyed || isOutOfBounds;
+    }
+};
+
+/**
+ * @brief Headless Box2D copy of a level built straight from the level json.
+ *
+ * The simulation has no sprites, textures or window, so tools can step levels without running the game.
+ * Objects are created in the same way as LevelLoader creates them and take damage from the same DamageTable as in game.
+ * Birds are not created since they are disabled until launched.
+ */
+class LevelSimulation {
+    public:
+        LevelSimulation(const json& levelJson);
+        LevelSimulation(const LevelSimulation&) = delete;
+        LevelSimulation& operator=(const LevelSimulation&) = delete;
+        void step();
+        void run(float seconds);
+        void wakeAll();
+        bool isAsleep() const;
+        float getElapsedTime() const;
+        const std::vector<SimulatedObject>& getObjects() const;
+    private:
+        b2World world_;
+        std::vector<SimulatedObject> objects_;
+        int steps_ = 0;
+        void createObject(int index, const json& objectJson);
+        void handleCollisions();
+        void applyImpact(SimulatedObject& object, const SimulatedObject& other);
+};
+
+#endif // LEVEL_SIMULATION_HPP
@@ -0,0 +1,275 @@
+#include "level_validator.hpp"
+#include "level_simulation.hpp"
+#include "utils.hpp"
+#include "pig.hpp"
+#include "wall.hpp"
+#include <fstream>
+#include <sstream>
+
+// Rounding in the editor's saved positions is allowed up to one pixel
+const float PLACEMENT_TOLERANCE = 1.f;
+
+void to_json(json& j, const ValidationIssue& issue) {
+    j = json{
+        {"check", issue.check},
+        {"message", issue.message},
+        {"objects", issue.objects}
+    };
+}
+
+void to_json(json& j, const LevelReport& report) {
+    j = json{
+        {"file", report.file},
+        {"valid", report.isValid()},
+        {"issues", report.issues}
+    };
+}
+
+namespace {
+    std::string getTypeName(Object::Type type) {
+        switch (type) {
+            case Object::Type::Pig:
+                return "Pig";
+            case Object::Type::Wall:
+                return "Wall";
+            case Object::Type::Ground:
+                return "Ground";
+            default:
+                return "Bird";
+        }
+    }
+
+    // Corners of the object in SFML coordinates, pigs are unrotated squares like their sprites in the level editor
+    std::array<sf::Vector2f, 4> getCorners(const ObjectData& data, const ShapeData& shapeData) {
+        sf::Vector2f center = utils::B2ToSfCoords(data.position);
+        if (data.type == Object::Type::Pig) {
+            float radius = utils::B2ToSf(shapeData.radius);
+            return utils::getBoxCorners(center, sf::Vector2f(radius, radius), 0);
+        }
+        return utils::getBoxCorners(center, utils::B2ToSf(shapeData.dimensions), -utils::RadiansToDegrees(data.angle));
+    }
+}
+
+LevelValidator::LevelValidator(float settleTime) : settleTime_(settleTime) {}
+
+LevelReport LevelValidator::validate(const fs::path& file) const {
+    LevelReport report;
+    report.file = file.filename().string();
+    std::ifstream inFile(file);
+    if (!inFile.is_open()) {
+        report.issues.push_back({"schema", "Failed to open file: " + file.string()});
+        return report;
+    }
+    json levelJson;
+    try {
+        inFile >> levelJson;
+    } catch (const json::exception& e) {
+        report.issues.push_back({"schema", std::string("Invalid json: ") + e.what()});
+        return report;
+    }
+    std::vector<Definition> definitions;
+    if (!checkSchema(levelJson, definitions, report)) {
+        return report; // The level can't be built, so the remaining checks can't run
+    }
+    checkOverlaps(definitions, report);
+    ChunkIndex chunkIndex;
+    checkChunks(levelJson, file.parent_path(), chunkIndex, report);
+    checkPlacement(definitions, chunkIndex.getWorldWidth(), report);
+    checkStability(levelJson, report);
+    return report;
+}
+
+bool LevelValidator::checkSchema(const json& levelJson, std::vector<Definition>& definitions, LevelReport& report) const {
+    size_t issueCount = report.issues.size();
+    if (!levelJson.is_object()) {
+        report.issues.push_back({"schema", "Level should be a json object"});
+        return false;
+    }
+    if (!levelJson.contains("id") || !levelJson["id"].is_number_integer()) {
+        report.issues.push_back({"schema", "Level should have an integer id"});
+    }
+    if (!levelJson.contains("highScores") || !levelJson["highScores"].is_array()) {
+        report.issues.push_back({"schema", "Level should have a highScores array"});
+    }
+    checkBirds(levelJson, report);
+    if (!levelJson.contains("objects") || !levelJson["objects"].is_array()) {
+        report.issues.push_back({"schema", "Level should have an objects array"});
+        return false;
+    }
+    int groundCount = 0;
+    int index = 0;
+    for (const auto& objectJson : levelJson["objects"]) {
+        Definition definition;
+        definition.index = index++;
+        try {
+            objectJson.at("body").get_to(definition.data);
+            objectJson.at("shape").get_to(definition.shapeData);
+        } catch (const json::exception& e) {
+            report.issues.push_back({"schema", std::string("Invalid object: ") + e.what(), {definition.index}});
+            continue;
+        } catch (const std::runtime_error& e) {
+            // from_json throws runtime_error for unknown object types
+            report.issues.push_back({"type", e.what(), {definition.index}});
+            continue;
+        }
+        Object::Type type = definition.data.type;
+        int shapeType = definition.shapeData.shapeType;
+        if (type == Object::Type::Bird) {
+            report.issues.push_back({"type", "Birds should be in the birds list, not in the objects list", {definition.index}});
+            continue;
+        }
+        if (type == Object::Type::Pig && shapeType != b2Shape::e_circle) {
+            report.issues.push_back({"type", "Pig should have a circle shape", {definition.index}});
+            continue;
+        }
+        if (type != Object::Type::Pig && shapeType != b2Shape::e_polygon) {
+            report.issues.push_back({"type", getTypeName(type) + " should have a polygon shape", {definition.index}});
+            continue;
+        }
+        if (type == Object::Type::Ground) {
+            groundCount++;
+        }
+        definitions.push_back(definition);
+    }
+    if (groundCount != 1) {
+        report.issues.push_back({"type", "Level should have exactly one ground, found " + std::to_string(groundCount)});
+    }
+    return report.issues.size() == issueCount;
+}
+
+void LevelValidator::checkBirds(const json& levelJson, LevelReport& report) const {
+    if (!levelJson.contains("birds") || !levelJson["birds"].is_object()) {
+        report.issues.push_back({"schema", "Level should have a birds object"});
+        return;
+    }
+    const json& birds = levelJson["birds"];
+    if (!birds.contains("list") || !birds["list"].is_array() || birds["list"].empty()) {
+        report.issues.push_back({"schema", "Level should contain at least one bird"});
+    } else {
+        for (const auto& birdType : birds["list"]) {
+            if (birdType != "R" && birdType != "L" && birdType != "G" && birdType != "X") {
+                report.issues.push_back({"type", "Invalid bird type " + birdType.dump() + ". Should be one of R, L, G, X"});
+            }
+        }
+    }
+    try {
+        ObjectData data = birds.at("object").at("body").get<ObjectData>();
+        ShapeData shapeData = birds.at("object").at("shape").get<ShapeData>();
+        if (data.type != Object::Type::Bird || shapeData.shapeType != b2Shape::e_circle) {
+            report.issues.push_back({"type", "Bird object should be of type B with a circle shape"});
+        }
+    } catch (const json::exception& e) {
+        report.issues.push_back({"schema", std::string("Invalid bird object: ") + e.what()});
+    } catch (const std::runtime_error& e) {
+        report.issues.push_back({"type", e.what()});
+    }
+}
+
+// Same OBB test as LevelEditor::checkPosition uses for intersecting objects
+void LevelValidator::checkOverlaps(const std::vector<Definition>& definitions, LevelReport& report) const {
+    std::vector<std::array<sf::Vector2f, 4>> corners;
+    corners.reserve(definitions.size());
+    for (const auto& definition : definitions) {
+        corners.push_back(getCorners(definition.data, definition.shapeData));
+    }
+    for (size_t i = 0; i < definitions.size(); i++) {
+        if (definitions[i].data.type == Object::Type::Ground) {
+            continue;
+        }
+        for (size_t j = i + 1; j < definitions.size(); j++) {
+            if (definitions[j].data.type == Object::Type::Ground) {
+                continue;
+            }
+            if (utils::checkOBBCollision(corners[i], corners[j])) {
+                std::ostringstream message;
+                message << getTypeName(definitions[i].data.type) << " " << definitions[i].index << " overlaps "
+                        << getTypeName(definitions[j].data.type) << " " << definitions[j].index;
+                report.issues.push_back({"overlap", message.str(), {definitions[i].index, definitions[j].index}});
+            }
+        }
+    }
+}
+
+// Chunk files should be readable and have as many pigs as the index says, the game counts them before they are loaded
+void LevelValidator::checkChunks(const json& levelJson, const fs::path& directory, ChunkIndex& index, LevelReport& report) const {
+    try {
+        index = LevelLoader::readChunkIndex(levelJson);
+    } catch (const std::exception& e) {
+        report.issues.push_back({"chunk", std::string("Invalid chunk index: ") + e.what()});
+        index = ChunkIndex();
+        return;
+    }
+    for (const auto& info : index.chunks) {
+        try {
+            auto objects = LevelLoader::readChunkFile((directory / info.file).string());
+            int pigCount = 0;
+            for (const auto& object : objects) {
+                if (object.data.type == Object::Type::Pig) {
+                    pigCount++;
+                }
+            }
+            if (pigCount != info.pigCount) {
+                report.issues.push_back({"chunk", info.file + " has " + std::to_string(pigCount) + " pigs, index says " + std::to_string(info.pigCount)});
+            }
+        } catch (const std::exception& e) {
+            report.issues.push_back({"chunk", e.what()});
+        }
+    }
+}
+
+// Same world limits as LevelEditor::checkPosition clamps objects to, wider for chunked levels
+void LevelValidator::checkPlacement(const std::vector<Definition>& definitions, float worldWidth, LevelReport& report) const {
+    float worldTop = -VIEW.getHeight() + 200;
+    float groundTop = VIEW.getHeight() - 50;
+    for (const auto& definition : definitions) {
+        if (definition.data.type == Object::Type::Ground) {
+            continue;
+        }
+        auto corners = getCorners(definition.data, definition.shapeData);
+        sf::Vector2f min = corners[0];
+        sf::Vector2f max = corners[0];
+        for (const auto& corner : corners) {
+            min.x = std::min(min.x, corner.x);
+            min.y = std::min(min.y, corner.y);
+            max.x = std::max(max.x, corner.x);
+            max.y = std::max(max.y, corner.y);
+        }
+        std::string name = getTypeName(definition.data.type) + " " + std::to_string(definition.index);
+        if (min.x < -PLACEMENT_TOLERANCE || max.x > worldWidth + PLACEMENT_TOLERANCE) {
+            report.issues.push_back({"placement", name + " is outside of the world width", {definition.index}});
+        }
+        if (min.y < worldTop - PLACEMENT_TOLERANCE) {
+            report.issues.push_back({"placement", name + " is above the top of the world", {definition.index}});
+        }
+        if (max.y > groundTop + PLACEMENT_TOLERANCE) {
+            report.issues.push_back({"placement", name + " is inside the ground", {definition.index}});
+        }
+    }
+}
+
+void LevelValidator::checkStability(const json& levelJson, LevelReport& report) const {
+    LevelSimulation simulation(levelJson);
+    // Baked levels are saved asleep, wake them so objects at rest are actually tested
+    simulation.wakeAll();
+    simulation.run(settleTime_);
+    for (const auto& object : simulation.getObjects()) {
+        if (object.type == Object::Type::Ground) {
+            continue;
+        }
+        std::string name = getTypeName(object.type) + " " + std::to_string(object.index);
+        float startHealth = object.type == Object::Type::Pig ? PIG_HEALTH : WALL_HEALTH;
+        std::ostringstream message;
+        if (object.isOutOfBounds) {
+            message << name << " fell out of the world";
+        } else if (object.isDestroyed) {
+            message << name << " was destroyed without any input";
+        } else if (object.health < startHealth) {
+            message << name << " lost " << startHealth - object.health << " health without any input";
+        } else if (utils::isBodyMoving(object.body)) {
+            message << name << " is still moving after " << simulation.getElapsedTime() << " seconds";
+        } else {
+            continue;
+        }
+        report.issues.push_back({"stability", message.str(), {object.index}});
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef LEVEL_VALIDATOR_HPP
+#define LEVEL_VALIDATOR_HPP
+
+#include <string>
+#include <vector>
+#include "level_loader.hpp"
+
+/**
+ * @brief A single problem found in a level file
+ *
+ * @param check The check that found the problem, one of schema, type, overlap, placement or stability
+ * @param message Human readable description of the problem
+ * @param objects Indices of the objects in the level's objects array that the problem concerns
+ */
+struct ValidationIssue {
+    std::string check;
+    std::string message;
+    std::vector<int> objects;
+};
+
+struct LevelReport {
+    std::string file;
+    std::vector<ValidationIssue> issues;
+    bool isValid() const {
+        return issues.empty();
+    }
+};
+
+void to_json(json& j, const ValidationIssue& issue);
+void to_json(json& j, const LevelReport& report);
+
+/**
+ * @brief Validates level files without running the game
+ *
+ * Checks the json schema and object types, overlapping objects with the same OBB test as the level editor,
+ * objects placed outside of the world, the chunk files of wide levels and whether the level stays still when it is simulated without any input.
+ * The validator is stateless, so the same instance can validate levels from several threads at once.
+ */
+class LevelValidator {
+    public:
+        LevelValidator(float settleTime = 5.f);
+        LevelReport validate(const fs::path& file) const;
+    private:
+        // Level object that passed the schema checks
+        struct Definition {
+            int index;
+            ObjectData data;
+            ShapeData shapeData;
+        };
+        float settleTime_; // Seconds the level is simulated before checking stability
+        bool checkSchema(const json& levelJson, std::vector<Definition>& definitions, LevelReport& report) const;
+        void checkBirds(const json& levelJson, LevelReport& report) const;
+        void checkOverlaps(const std::vector<Definition>& definitions, LevelReport& report) const;
+        void checkChunks(const json& levelJson, const fs::path& directory, ChunkIndex& index, LevelReport& report) const;
+        void checkPlacement(const std::vector<Definition>& definitions, float worldWidth, LevelReport& report) const;
+        void checkStability(const json& levelJson, LevelReport& report) const;
+};
+
+#endif // LEVEL_VALIDATOR_HPP
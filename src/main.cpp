@@ -1,8 +1,28 @@
 #include "game.hpp"
+#include "trace.hpp"
+#include "alloc_tracker.hpp"
+#include "startup_profiler.hpp"
+#include <cstdlib>
+#include <iostream>
 
 int main()
 {
+   StartupProfiler::getInstance().mark("main");
+#ifdef AB_ALLOC_TRACKING
+   // Report every allocation made while a level runs after the first shot
+   if (std::getenv("AB_ALLOC_STRICT") != nullptr) {
+      AllocationTracker::getInstance().setStrict(true);
+   }
+#endif
    Game game;
    game.run();
+#ifdef AB_TRACING
+   // Write the trace of the whole session on exit
+   try {
+      trace::exportChromeTrace(utils::getExecutablePath() + "/trace.json");
+   } catch (const std::exception& e) {
+      std::cerr << "Failed to export trace: " << e.what() << std::endl;
+   }
+#endif
    return 0;
 }
\ No newline at end of file
@@ -9,7 +9,6 @@ MainMenu::MainMenu() : Menu(Menu::Type::MAIN) {
     updateMenuItems();
     // Create title
     setTitle("AngryBirds", 680.f, 340);
-    backgroundMusic_.play();
 };
 
 void MainMenu::handleResize() {
@@ -18,7 +17,7 @@ void MainMenu::handleResize() {
     setTitle("AngryBirds", 680.f, 340);
 };
 
-void MainMenu::draw(sf::RenderWindow& window) const {
+void MainMenu::draw(RenderQueue& window) const {
     window.draw(background_);
     window.draw(woodenSign_);
     // Draw the title characters
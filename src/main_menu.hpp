@@ -8,7 +8,7 @@
 class MainMenu: public Menu {
     public:
         MainMenu();
-        void draw(sf::RenderWindow& window) const override;
+        void draw(RenderQueue& window) const override;
         LevelSelector& getLevelSelector();
         UserSelector& getUserSelector();
         void handleResize() override;
@@ -12,9 +12,6 @@ Menu::Menu(Type type) : type_(type), menuItems_(buttonAmount_) {
     background_.setSize(sf::Vector2f(VIEW.getWidth(), VIEW.getHeight()));
     background_.setTexture(&ResourceManager::getInstance().getTexture("/assets/images/background.jpg"));
     background_.setPosition(0,0);
-    backgroundMusic_.setBuffer(ResourceManager::getInstance().getSoundBuffer("/assets/sounds/menu_2.wav"));
-    backgroundMusic_.setVolume(10);
-    backgroundMusic_.setLoop(true);
 }
 
 void Menu::handleResize() {
@@ -77,22 +74,6 @@ void Menu::handleMouseMove(const sf::Vector2f& mousePosition) {
     updateItem(LIME_GREEN, 1.1f);
 }
 
-void Menu::updateMusic(sf::SoundSource::Status newStatus) {
-    switch (newStatus) {
-        case sf::SoundSource::Status::Playing:
-            backgroundMusic_.play();
-            break;
-        case sf::SoundSource::Status::Paused:
-            backgroundMusic_.pause();
-            break;
-        case sf::SoundSource::Status::Stopped:
-            backgroundMusic_.stop();
-            break;
-        default:
-            break;
-    }
-}
-
 void Menu::setTitle(const std::string& title, float radius, int yOffset) {
     ResourceManager& resourceManager = ResourceManager::getInstance();
     sf::Vector2f SCREEN_CENTER = VIEW.getCenter();
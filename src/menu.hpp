@@ -2,7 +2,7 @@
 #define MENU_HPP
 
 #include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
+#include "render_queue.hpp"
 
 struct MenuItemLayout {
     int yOffset; // The y offset of the menu item from reference point.
@@ -21,7 +21,7 @@ class Menu {
         };
         Menu(Type type);
         virtual ~Menu() = default;
-        virtual void draw(sf::RenderWindow& window) const = 0;
+        virtual void draw(RenderQueue& window) const = 0;
         const int getSelectedItem() const;
         void setSelectedItem(int nextItem);
         const Type getType() const;
@@ -29,7 +29,6 @@ class Menu {
         virtual bool handleMouseClick(const sf::Vector2f& mousePosition);
         virtual void handleMouseMove(const sf::Vector2f& mousePosition);
         virtual void handleKeyPress(const sf::Keyboard::Key& code);
-        void updateMusic(sf::SoundSource::Status status);
         virtual void handleResize();
         virtual void handleResize(const sf::RenderWindow&) {};
         virtual void handleTextEntered(const sf::Uint32& unicode) {}; // Handle text input, default is empty
@@ -39,7 +38,6 @@ class Menu {
     protected:
         sf::RectangleShape woodenSign_;
         sf::RectangleShape background_;
-        sf::Sound backgroundMusic_;
         int buttonAmount_ = 0;
         std::vector<sf::Text> menuItems_;
         std::vector<sf::Text> title_;
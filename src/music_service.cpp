@@ -0,0 +1,84 @@
+#include "music_service.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+MusicService::MusicService() {
+    loadTracks();
+}
+
+MusicService& MusicService::getInstance() {
+    static MusicService instance;
+    return instance;
+}
+
+void MusicService::loadTracks() {
+    std::string path = utils::getExecutablePath() + "/assets/data/music.json";
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    json musicJson;
+    file >> musicJson;
+    file.close();
+    const std::array<std::pair<const char*, Track>, 3> names = {{
+        {"menu", Track::MENU},
+        {"level", Track::LEVEL},
+        {"editor", Track::EDITOR}
+    }};
+    const json& tracksJson = musicJson.at("tracks");
+    for (const auto& [name, track] : names) {
+        if (!tracksJson.contains(name)) {
+            continue;
+        }
+        MusicTrack& musicTrack = tracks_[static_cast<size_t>(track)];
+        tracksJson.at(name).at("file").get_to(musicTrack.file);
+        musicTrack.volume = tracksJson.at(name).value("volume", musicTrack.volume);
+    }
+}
+
+// Starts streaming the track on the free channel, the current track fades out in update
+void MusicService::play(Track track) {
+    if (channels_[current_].track == track) {
+        return;
+    }
+    // A crossfade in progress is cut short, its outgoing track is stopped
+    size_t next = 1 - current_;
+    Channel& channel = channels_[next];
+    channel.music.stop();
+    channel.track = track;
+    channel.volume = 0;
+    const MusicTrack& musicTrack = tracks_[static_cast<size_t>(track)];
+    if (!musicTrack.file.empty()) {
+        std::string path = utils::getExecutablePath() + musicTrack.file;
+        if (!channel.music.openFromFile(path)) {
+            throw std::runtime_error("Failed to open file: " + path);
+        }
+        channel.volume = musicTrack.volume;
+        channel.music.setLoop(true);
+        channel.music.setVolume(0);
+        channel.music.play();
+    }
+    current_ = next;
+    fade_ = 0;
+    fadeClock_.restart();
+}
+
+// Advances the crossfade, called every frame
+void MusicService::update() {
+    if (fade_ >= 1.f) {
+        return;
+    }
+    fade_ = std::min(1.f, fadeClock_.getElapsedTime().asSeconds() / MUSIC_CROSSFADE_TIME);
+    Channel& incoming = channels_[current_];
+    Channel& outgoing = channels_[1 - current_];
+    incoming.music.setVolume(incoming.volume * fade_);
+    outgoing.music.setVolume(outgoing.volume * (1.f - fade_));
+    if (fade_ >= 1.f) {
+        outgoing.music.stop();
+        outgoing.track = Track::NONE;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef MUSIC_SERVICE_HPP
+#define MUSIC_SERVICE_HPP
+
+#include <SFML/Audio.hpp>
+#include <array>
+#include <string>
+
+const float MUSIC_CROSSFADE_TIME = 1.5f; // Seconds the previous track fades out while the next one fades in
+
+/**
+ * @brief Track of a music slot
+ *
+ * @param file Path of the music file, empty for silence
+ * @param volume Volume of the track, 0 - 100
+ */
+struct MusicTrack {
+    std::string file;
+    float volume = 10.f;
+};
+
+/**
+ * @brief Plays the background music shared by the menus, the levels and the level editor
+ *
+ * Tracks are streamed from disk with sf::Music instead of being decoded into memory, and switching tracks crossfades
+ * between two streams. The tracks are defined in assets/data/music.json, a missing track is silent. Used by the main thread.
+ */
+class MusicService {
+    public:
+        enum class Track {
+            NONE,
+            MENU,
+            LEVEL,
+            EDITOR,
+        };
+        static MusicService& getInstance();
+        MusicService(const MusicService&) = delete;
+        MusicService& operator=(const MusicService&) = delete;
+        void play(Track track);
+        void update();
+    private:
+        struct Channel {
+            sf::Music music;
+            Track track = Track::NONE;
+            float volume = 0;
+        };
+        MusicService();
+        void loadTracks();
+        std::array<MusicTrack, 4> tracks_;
+        std::array<Channel, 2> channels_;
+        size_t current_ = 0; // Channel fading in or playing
+        float fade_ = 1.f; // Progress of the crossfade, 0 - 1
+        sf::Clock fadeClock_;
+};
+
+#endif // MUSIC_SERVICE_HPP
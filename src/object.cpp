@@ -1,9 +1,19 @@
 #include "object.hpp"
 #include "utils.hpp"
 #include "resource_manager.hpp"
+#include <atomic>
 
-Object::Object(b2Body *body, Type type, std::string texture_file, float health, bool isDestrucable) : body_(body), type_(type), health_(health), isDestrucable_(isDestrucable) {
-    sprite_.setTexture(ResourceManager::getInstance().getTexture(texture_file));
+namespace {
+    // Objects are created by the main thread and, for level chunks, by the physics thread
+    std::atomic<uint32_t> nextObjectId{0};
+}
+
+Object::Object(b2Body *body, Type type, std::string texture_file, float health, bool isDestrucable)
+    : Object(body, type, ResourceManager::getInstance().getTexture(texture_file), health, isDestrucable) {}
+
+// The texture is resolved by the caller, objects of level chunks are created on the physics thread
+Object::Object(b2Body *body, Type type, const sf::Texture& texture, float health, bool isDestrucable) : body_(body), type_(type), health_(health), isDestrucable_(isDestrucable), id_(nextObjectId++) {
+    sprite_.setTexture(texture);
 }
 
 b2Body* Object::getBody() {
@@ -26,8 +36,26 @@ sf::Sprite& Object::getSprite() {
     return sprite_;
 }
 
-void Object::handleCollision(Object* objectB) {
-    // Default implementation does nothing
+// Damage from a blast or a contact resolved by the DamageTable, returns whether it destroyed the object
+bool Object::applyDamage(float damage) {
+    if (!isDestrucable_ || isDestroyed_ || damage <= 0) {
+        return false;
+    }
+    health_ -= damage;
+    if (health_ <= 0) {
+        isDestroyed_ = true;
+        return true;
+    }
+    return false;
+}
+
+int Object::getDamageMultiplier() const {
+    return damageMultiplier_;
+}
+
+// Height of the body after the previous update, the DamageTable uses it for fall damage
+float Object::getPrevY() const {
+    return prevY_;
 }
 
 bool Object::isDestroyed() const {
@@ -35,13 +63,34 @@ bool Object::isDestroyed() const {
 }
 
 bool Object::isOutOfBounds() const {
-    sf::Vector2f position = utils::B2ToSfCoords(body_->GetPosition());
-    return position.x < 0 || position.y > VIEW.getHeight() || position.x > WORLD_WIDTH;
+    return utils::isOutOfBounds(body_->GetPosition());
 }
 
+// Asleep bodies don't move, so only awake, just fallen asleep or dirty objects have their sprite transform refreshed
 void Object::update() {
+    prevY_ = body_->GetPosition().y;
+    bool isAwake = body_->IsAwake();
+    if (!isAwake && !wasAwake_ && !isDirty_) {
+        return;
+    }
+    wasAwake_ = isAwake;
+    isDirty_ = false;
+    updateTransform();
+    renderVersion_++;
+}
+
+// Force a transform refresh on the next update, e.g. after moving the body manually or resizing the window
+void Object::markDirty() {
+    isDirty_ = true;
+}
+
+// Changes whenever the sprite of the object changes, used as part of the key of the cached static layer
+uint64_t Object::getRenderKey() const {
+    return (static_cast<uint64_t>(id_) << 32) | renderVersion_;
+}
+
+void Object::updateTransform() {
     b2Vec2 position = body_->GetPosition();
-    prevY_ = position.y;
     sf::Sprite& sprite = this->getSprite();
     sf::Vector2f position_pixels = utils::B2ToSfCoords(position);
     sprite.setPosition(position_pixels.x, position_pixels.y);
@@ -51,10 +100,7 @@ void Object::update() {
 }
 
 bool Object::isMoving() const {
-    return (
-        body_->GetLinearVelocity().LengthSquared() > IS_SETTLED_THRESHOLD
-        || fabs(body_->GetAngularVelocity()) > IS_SETTLED_THRESHOLD
-    );
+    return utils::isBodyMoving(body_);
 }
 
 int Object::getDestructionScore() const {
@@ -65,6 +111,52 @@ bool Object::shouldRemove() const {
     return false;
 }
 
-void Object::draw(sf::RenderWindow &window) const {
+void Object::draw(RenderQueue& window) const {
     window.draw(sprite_);
+}
+
+// Copies the sprites that draw would draw, used for the render snapshots of the physics thread
+void Object::captureSprites(std::vector<sf::Sprite>& sprites) const {
+    sprites.push_back(sprite_);
+}
+
+void Object::saveState(ObjectState& state) const {
+    state.position = body_->GetPosition();
+    state.angle = body_->GetAngle();
+    state.linearVelocity = body_->GetLinearVelocity();
+    state.angularVelocity = body_->GetAngularVelocity();
+    state.gravityScale = body_->GetGravityScale();
+    state.health = health_;
+    state.isAwake = body_->IsAwake();
+    state.isEnabled = body_->IsEnabled();
+    state.isBullet = body_->IsBullet();
+    state.isDestroyed = isDestroyed_;
+    state.isRemoved = isRemoved_;
+}
+
+// Moves the existing body back to the saved state, sleeping bodies have no velocity so awake is set last
+void Object::restoreState(const ObjectState& state) {
+    body_->SetEnabled(state.isEnabled);
+    body_->SetTransform(state.position, state.angle);
+    body_->SetLinearVelocity(state.linearVelocity);
+    body_->SetAngularVelocity(state.angularVelocity);
+    body_->SetGravityScale(state.gravityScale);
+    body_->SetBullet(state.isBullet);
+    body_->SetAwake(state.isAwake);
+    health_ = state.health;
+    isDestroyed_ = state.isDestroyed;
+    isRemoved_ = state.isRemoved;
+    prevY_ = state.position.y;
+    markDirty();
+    update();
+}
+
+// Takes the object out of the simulation without destroying its body, so a restored state can bring it back
+void Object::disable() {
+    body_->SetEnabled(false);
+    isRemoved_ = true;
+}
+
+bool Object::isRemoved() const {
+    return isRemoved_;
 }
\ No newline at end of file
@@ -3,6 +3,42 @@
 
 #include <box2d/box2d.h>
 #include <SFML/Graphics.hpp>
+#include "render_queue.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Saved state of an object, restored in place without recreating its body
+ *
+ * @param position Body position in Box2D coordinates
+ * @param angle Body angle in radians
+ * @param linearVelocity Body linear velocity
+ * @param angularVelocity Body angular velocity
+ * @param gravityScale Body gravity scale, changed by some bird powers
+ * @param health Remaining health of the object
+ * @param isAwake Whether the body was awake
+ * @param isEnabled Whether the body took part in the simulation
+ * @param isBullet Whether the body used continuous collision, changed by some bird powers
+ * @param isDestroyed Whether the object was destroyed
+ * @param isRemoved Whether the object was taken out of the simulation
+ * @param isLaunched Whether the bird was launched, only used by birds
+ * @param isPowerUsed Whether the bird had used its power, only used by birds
+ */
+struct ObjectState {
+    b2Vec2 position = b2Vec2_zero;
+    float angle = 0;
+    b2Vec2 linearVelocity = b2Vec2_zero;
+    float angularVelocity = 0;
+    float gravityScale = 1;
+    float health = 0;
+    bool isAwake = false;
+    bool isEnabled = true;
+    bool isBullet = false;
+    bool isDestroyed = false;
+    bool isRemoved = false;
+    bool isLaunched = false;
+    bool isPowerUsed = false;
+};
 
 /**
  * @brief Object class, the base class for all objects in the game, Bird, Pig, Ground, Wall and MiniBird
@@ -17,32 +53,48 @@ class Object {
             MiniBird  // A smaller projectile of the original bird
         };
         Object(b2Body *body, Type type, std::string texture_file, float health = 0, bool isDestrucable = false);
+        Object(b2Body *body, Type type, const sf::Texture& texture, float health = 0, bool isDestrucable = false);
         virtual ~Object() = default;
-        virtual void draw(sf::RenderWindow &window) const;
+        virtual void draw(RenderQueue& window) const;
+        virtual void captureSprites(std::vector<sf::Sprite>& sprites) const;
         b2Body* getBody();
         const b2Body* getBody() const;
         sf::Sprite& getSprite();
         const sf::Sprite& getSprite() const;
         virtual char getTypeAsChar() const = 0;
         Type getType() const;
-        virtual void handleCollision(Object* objectB);
+        bool applyDamage(float damage);
         bool isDestroyed() const;
         virtual void update();
+        void markDirty();
+        uint64_t getRenderKey() const;
         virtual bool isMoving() const;
         virtual int getDestructionScore() const;
         bool isOutOfBounds() const;
         virtual bool shouldRemove() const;
-        virtual int getDamageMultiplier() const { return 1; }
+        int getDamageMultiplier() const;
+        float getPrevY() const;
+        virtual void saveState(ObjectState& state) const;
+        virtual void restoreState(const ObjectState& state);
+        virtual void disable();
+        bool isRemoved() const;
     protected:
         sf::Sprite sprite_;
         b2Body *body_;
         float health_;
         bool isDestrucable_;
         bool isDestroyed_ = false;
+        bool isRemoved_ = false;
         float prevY_ = 0;
+        int damageMultiplier_ = 1; // Scales the contact damage this object deals, or takes for self scaled rules of the DamageTable
+        virtual void updateTransform();
     private:
         
         Type type_;
+        bool isDirty_ = true; // Sprite transform has not been synced since the last external change
+        bool wasAwake_ = false; // Body was awake on the previous update, its final position before sleeping must be synced
+        uint32_t id_; // Unique among all objects created, so objects of a new level never share render keys with old ones
+        uint32_t renderVersion_ = 0; // Incremented whenever the sprite transform changes
        
 };
 
@@ -0,0 +1,85 @@
+#include "parallax_background.hpp"
+#include "resource_manager.hpp"
+#include "utils.hpp"
+#include <cmath>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+ParallaxBackground::ParallaxBackground() {
+    loadLayers();
+    handleResize();
+}
+
+void ParallaxBackground::loadLayers() {
+    std::string path = utils::getExecutablePath() + "/assets/data/parallax.json";
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    json parallaxJson;
+    file >> parallaxJson;
+    file.close();
+    const auto& skyJson = parallaxJson.at("sky");
+    sky_ = sf::Color(skyJson.at(0).get<sf::Uint8>(), skyJson.at(1).get<sf::Uint8>(), skyJson.at(2).get<sf::Uint8>());
+    ResourceManager& resourceManager = ResourceManager::getInstance();
+    for (const auto& layerJson : parallaxJson.at("layers")) {
+        ParallaxLayer layer;
+        sf::Texture& texture = resourceManager.getTexture(layerJson.at("texture").get<std::string>());
+        texture.setRepeated(true);
+        layer.texture = &texture;
+        layerJson.at("parallax").get_to(layer.parallax);
+        layerJson.at("top").get_to(layer.top);
+        layer.topOffset = layerJson.value("topOffset", 0.f);
+        layerJson.at("height").get_to(layer.height);
+        layers_.push_back(layer);
+    }
+}
+
+// Layers are sized by the view height, their width repeats
+void ParallaxBackground::handleResize() {
+    float viewHeight = VIEW.getHeight();
+    for (auto& layer : layers_) {
+        layer.y = layer.top * viewHeight + layer.topOffset;
+        layer.scale = layer.height * viewHeight / layer.texture->getSize().y;
+    }
+}
+
+// Sky and the scrolling strips, drawn every frame
+void ParallaxBackground::draw(RenderQueue& window) const {
+    window.clear(sky_);
+    const sf::View& view = window.getView();
+    float viewLeft = view.getCenter().x - view.getSize().x / 2.f;
+    for (const auto& layer : layers_) {
+        if (layer.parallax != 1.f) {
+            drawLayer(window, layer, viewLeft, view.getSize().x);
+        }
+    }
+}
+
+// Strips that move with the world, they also cover the margin of the cached static layer around the view
+void ParallaxBackground::drawBase(RenderQueue& window) const {
+    const sf::View& view = window.getView();
+    float width = view.getSize().x * (1.f + 2.f * LAYER_MARGIN);
+    float left = view.getCenter().x - width / 2.f;
+    for (const auto& layer : layers_) {
+        if (layer.parallax == 1.f) {
+            drawLayer(window, layer, left, width);
+        }
+    }
+}
+
+void ParallaxBackground::drawLayer(RenderQueue& window, const ParallaxLayer& layer, float left, float width) {
+    const sf::View& view = window.getView();
+    // World x of the texture origin, the layers line up with the world at the default camera position
+    // and a layer with parallax 0.5 moves half as far as the camera
+    float origin = (view.getCenter().x - VIEW.getCenter().x) * (1.f - layer.parallax);
+    // First texel column in the covered area, the texture rect starts there so the quad only covers that area
+    int column = static_cast<int>(std::floor((left - origin) / layer.scale));
+    int columns = static_cast<int>(std::ceil(width / layer.scale)) + 2;
+    sf::Sprite sprite(*layer.texture, sf::IntRect(column, 0, columns, layer.texture->getSize().y));
+    sprite.setScale(layer.scale, layer.scale);
+    sprite.setPosition(origin + column * layer.scale, layer.y);
+    window.draw(sprite);
+}
@@ -0,0 +1,51 @@
+#ifndef PARALLAX_BACKGROUND_HPP
+#define PARALLAX_BACKGROUND_HPP
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "render_queue.hpp"
+
+/**
+ * @brief Horizontal strip of a parallax background
+ *
+ * @param texture Small tileable texture of the strip, repeated along the strip, owned by the ResourceManager
+ * @param parallax How fast the strip scrolls with the camera, 1 moves with the world and 0 stays on screen
+ * @param top Top of the strip in view heights, plus topOffset pixels
+ * @param topOffset Offset of the top in pixels
+ * @param height Height of the strip in view heights, the texture is scaled to it
+ * @param y Top of the strip in SFML coordinates for the current view size
+ * @param scale Scale of the texture for the current view size
+ */
+struct ParallaxLayer {
+    const sf::Texture* texture = nullptr;
+    float parallax = 1.f;
+    float top = 0;
+    float topOffset = 0;
+    float height = 1.f;
+    float y = 0;
+    float scale = 1.f;
+};
+
+/**
+ * @brief Background of the world built from horizontally repeating strips, each scrolling at its own rate
+ *
+ * The sky color and the strips are defined in assets/data/parallax.json and drawn back to front. The sky is the clear
+ * color of the frame, so it costs no fill. Each strip is one quad only as tall as the strip and as wide as the view,
+ * with texture coordinates past its small tileable texture wrapping around, so any world width is covered.
+ * Strips with parallax 1 move with the world and are drawn by drawBase, which the World records into its cached
+ * static layer, only the strips scrolling at other rates are redrawn every frame.
+ */
+class ParallaxBackground {
+    public:
+        ParallaxBackground();
+        void handleResize();
+        void draw(RenderQueue& window) const;
+        void drawBase(RenderQueue& window) const;
+    private:
+        sf::Color sky_;
+        std::vector<ParallaxLayer> layers_;
+        void loadLayers();
+        static void drawLayer(RenderQueue& window, const ParallaxLayer& layer, float left, float width);
+};
+
+#endif // PARALLAX_BACKGROUND_HPP
@@ -0,0 +1,149 @@
+#include "particle_system.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+
+ParticleSystem::ParticleSystem() : vertices_(sf::Quads, PARTICLE_CAPACITY * 4) {
+    // Sized once for the whole pool, clearing keeps the storage
+    vertices_.clear();
+    age_.fill(0);
+    lifetime_.fill(0);
+}
+
+// Spawns count particles of the effect around position, size is the size of the destroyed object in pixels
+void ParticleSystem::emit(Effect effect, const sf::Vector2f& position, float size, const sf::Color& color, int count) {
+    float spread = size * 0.5f;
+    for (int i = 0; i < count; i++) {
+        size_t index = next_;
+        next_ = (next_ + 1) % PARTICLE_CAPACITY;
+        used_ = std::min(used_ + 1, static_cast<size_t>(PARTICLE_CAPACITY));
+        x_[index] = position.x + getRandom(-spread, spread);
+        y_[index] = position.y + getRandom(-spread, spread);
+        rotation_[index] = getRandom(0.f, 360.f);
+        color_[index] = color;
+        age_[index] = 0;
+        switch (effect) {
+            case Effect::Debris:
+                velocityX_[index] = getRandom(-250.f, 250.f);
+                velocityY_[index] = getRandom(-450.f, -100.f);
+                spin_[index] = getRandom(-720.f, 720.f);
+                size_[index] = getRandom(0.08f, 0.18f) * size;
+                gravityScale_[index] = 1.f;
+                drag_[index] = 0.2f;
+                lifetime_[index] = getRandom(1.f, 1.8f);
+                break;
+            case Effect::Dust:
+                velocityX_[index] = getRandom(-60.f, 60.f);
+                velocityY_[index] = getRandom(-80.f, -10.f);
+                spin_[index] = getRandom(-90.f, 90.f);
+                size_[index] = getRandom(0.2f, 0.4f) * size;
+                gravityScale_[index] = -0.02f;
+                drag_[index] = 1.5f;
+                lifetime_[index] = getRandom(0.6f, 1.2f);
+                break;
+            case Effect::Feathers:
+                velocityX_[index] = getRandom(-150.f, 150.f);
+                velocityY_[index] = getRandom(-250.f, -50.f);
+                spin_[index] = getRandom(-360.f, 360.f);
+                size_[index] = getRandom(0.1f, 0.2f) * size;
+                gravityScale_[index] = 0.15f;
+                drag_[index] = 2.5f;
+                lifetime_[index] = getRandom(1.5f, 2.5f);
+                break;
+        }
+    }
+}
+
+// Effects of an object removed by the physics thread, type is the one of Object::getTypeAsChar or F for a wall fragment
+void ParticleSystem::emitDestruction(char type, const sf::Vector2f& position, float size) {
+    switch (type) {
+        case 'W':
+            emit(Effect::Debris, position, size, sf::Color(150, 105, 60), 14);
+            emit(Effect::Dust, position, size, sf::Color(200, 190, 170, 160), 6);
+            break;
+        case 'P':
+            emit(Effect::Debris, position, size, sf::Color(110, 190, 60), 8);
+            emit(Effect::Dust, position, size, sf::Color(220, 230, 200, 160), 6);
+            break;
+        case 'R':
+            emit(Effect::Feathers, position, size, sf::Color(210, 40, 40), 12);
+            break;
+        case 'L':
+            emit(Effect::Feathers, position, size, sf::Color(90, 150, 230), 12);
+            break;
+        case 'G':
+            emit(Effect::Feathers, position, size, sf::Color(120, 200, 60), 12);
+            break;
+        case 'F':
+            emit(Effect::Debris, position, size, sf::Color(150, 105, 60), 4);
+            emit(Effect::Dust, position, size, sf::Color(200, 190, 170, 120), 2);
+            break;
+        case 'X':
+            emit(Effect::Dust, position, size * 3.f, sf::Color(90, 90, 90, 200), 24);
+            emit(Effect::Feathers, position, size, sf::Color(60, 60, 60), 12);
+            break;
+        default:
+            break;
+    }
+}
+
+void ParticleSystem::update(float deltaTime) {
+    liveCount_ = 0;
+    for (size_t i = 0; i < used_; i++) {
+        if (age_[i] >= lifetime_[i]) {
+            continue;
+        }
+        age_[i] += deltaTime;
+        float damping = std::max(0.f, 1.f - drag_[i] * deltaTime);
+        velocityX_[i] *= damping;
+        velocityY_[i] = velocityY_[i] * damping + PARTICLE_GRAVITY * gravityScale_[i] * deltaTime;
+        x_[i] += velocityX_[i] * deltaTime;
+        y_[i] += velocityY_[i] * deltaTime;
+        rotation_[i] += spin_[i] * deltaTime;
+        if (age_[i] < lifetime_[i]) {
+            liveCount_++;
+        }
+    }
+    updateVertices();
+}
+
+void ParticleSystem::clear() {
+    next_ = 0;
+    used_ = 0;
+    liveCount_ = 0;
+    vertices_.clear();
+}
+
+// All particles are drawn with a single vertex array draw
+void ParticleSystem::draw(RenderQueue& window) const {
+    window.draw(vertices_);
+}
+
+size_t ParticleSystem::getLiveCount() const {
+    return liveCount_;
+}
+
+float ParticleSystem::getRandom(float min, float max) {
+    return min + (max - min) * (random_() - random_.min()) / static_cast<float>(random_.max() - random_.min());
+}
+
+// Rebuilds the quads of the live particles, fading them out over their lifetime
+void ParticleSystem::updateVertices() {
+    vertices_.clear();
+    for (size_t i = 0; i < used_; i++) {
+        if (age_[i] >= lifetime_[i]) {
+            continue;
+        }
+        float radians = utils::DegreesToRadians(rotation_[i]);
+        float halfSize = size_[i] * 0.5f;
+        sf::Vector2f right(std::cos(radians) * halfSize, std::sin(radians) * halfSize);
+        sf::Vector2f down(-right.y, right.x);
+        sf::Vector2f center(x_[i], y_[i]);
+        sf::Color color = color_[i];
+        color.a = static_cast<sf::Uint8>(color.a * (1.f - age_[i] / lifetime_[i]));
+        vertices_.append(sf::Vertex(center - right - down, color));
+        vertices_.append(sf::Vertex(center + right - down, color));
+        vertices_.append(sf::Vertex(center + right + down, color));
+        vertices_.append(sf::Vertex(center - right + down, color));
+    }
+}
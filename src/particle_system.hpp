@@ -0,0 +1,55 @@
+#ifndef PARTICLE_SYSTEM_HPP
+#define PARTICLE_SYSTEM_HPP
+
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <random>
+#include "render_queue.hpp"
+
+const int PARTICLE_CAPACITY = 4096; // Global particle budget, the oldest particles are replaced when it is exceeded
+const float PARTICLE_GRAVITY = 900.f; // Pixels per second squared, downwards in SFML coordinates
+
+/**
+ * @brief Pooled debris, dust and feather particles of destroyed objects, updated and drawn by the main thread
+ *
+ * Particles live in fixed size arrays, one per attribute, used as a ring buffer, so emitting never allocates
+ * and a new particle replaces the oldest one once the budget is full. Particles are integrated with simple gravity and drag
+ * instead of Box2D bodies and drawn as rotated quads of one vertex array.
+ */
+class ParticleSystem {
+    public:
+        enum class Effect {
+            Debris, // Heavy chunks that tumble and fall fast
+            Dust, // Slow puffs that drift up and fade
+            Feathers // Light flakes that flutter down slowly
+        };
+        ParticleSystem();
+        void emit(Effect effect, const sf::Vector2f& position, float size, const sf::Color& color, int count);
+        void emitDestruction(char type, const sf::Vector2f& position, float size);
+        void update(float deltaTime);
+        void clear();
+        void draw(RenderQueue& window) const;
+        size_t getLiveCount() const;
+    private:
+        std::array<float, PARTICLE_CAPACITY> x_;
+        std::array<float, PARTICLE_CAPACITY> y_;
+        std::array<float, PARTICLE_CAPACITY> velocityX_;
+        std::array<float, PARTICLE_CAPACITY> velocityY_;
+        std::array<float, PARTICLE_CAPACITY> rotation_; // Degrees
+        std::array<float, PARTICLE_CAPACITY> spin_; // Degrees per second
+        std::array<float, PARTICLE_CAPACITY> size_;
+        std::array<float, PARTICLE_CAPACITY> gravityScale_;
+        std::array<float, PARTICLE_CAPACITY> drag_; // Fraction of the velocity lost per second
+        std::array<float, PARTICLE_CAPACITY> age_;
+        std::array<float, PARTICLE_CAPACITY> lifetime_;
+        std::array<sf::Color, PARTICLE_CAPACITY> color_;
+        size_t next_ = 0; // Slot of the next particle, the oldest particle once the pool is full
+        size_t used_ = 0; // Slots written since the last clear, at most PARTICLE_CAPACITY
+        size_t liveCount_ = 0;
+        sf::VertexArray vertices_;
+        std::minstd_rand random_;
+        float getRandom(float min, float max);
+        void updateVertices();
+};
+
+#endif // PARTICLE_SYSTEM_HPP
@@ -15,7 +15,7 @@ void Pause::handleResize(const sf::RenderWindow& window) {
     updatePosition(window);
 }
 
-void Pause::draw(sf::RenderWindow& window) const {
+void Pause::draw(RenderQueue& window) const {
     window.draw(woodenSign_);
     // Draw the title characters
     for (const auto& character : title_) {
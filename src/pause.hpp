@@ -10,7 +10,7 @@ class Pause : public Menu {
             LEVEL_EDITOR
         };
         Pause();
-        void draw(sf::RenderWindow& window) const override;
+        void draw(RenderQueue& window) const override;
         void handleResize(const sf::RenderWindow&) override;
         void handleResize() override;
         void updatePosition(const sf::RenderWindow& window);
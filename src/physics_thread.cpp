@@ -0,0 +1,96 @@
+#include "physics_thread.hpp"
+#include "trace.hpp"
+#include "alloc_tracker.hpp"
+#include <chrono>
+
+PhysicsThread::PhysicsThread(World& world) : world_(world) {
+    thread_ = std::thread(&PhysicsThread::run, this);
+}
+
+PhysicsThread::~PhysicsThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        isQuitting_ = true;
+    }
+    condition_.notify_all();
+    thread_.join();
+}
+
+void PhysicsThread::resume() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (isRunning_) {
+        return;
+    }
+    isRunning_ = true;
+    condition_.notify_all();
+}
+
+// Blocks until the current tick is finished, after that the caller can use the world freely
+void PhysicsThread::pause() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    isRunning_ = false;
+    condition_.notify_all();
+    condition_.wait(lock, [this] { return isIdle_; });
+}
+
+bool PhysicsThread::pushCommand(const WorldCommand& command) {
+    return commands_.push(command);
+}
+
+// Picks up the latest published snapshot, returns whether it is new
+bool PhysicsThread::updateSnapshot() {
+    return snapshots_.update();
+}
+
+const WorldSnapshot& PhysicsThread::getSnapshot() const {
+    return snapshots_.front();
+}
+
+// Publishes a snapshot from the calling thread, only allowed while paused, e.g. after loading a level
+void PhysicsThread::refreshSnapshot() {
+    WorldCommand command;
+    while (commands_.pop(command)) {} // Input for the previous world state is discarded
+    world_.captureSnapshot(snapshots_.back());
+    snapshots_.publish();
+}
+
+void PhysicsThread::run() {
+    trace::setThreadName("Physics");
+    const auto tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(TIME_STEP));
+    auto nextTick = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!isQuitting_) {
+        if (!isRunning_) {
+            isIdle_ = true;
+            condition_.notify_all();
+            condition_.wait(lock, [this] { return isRunning_ || isQuitting_; });
+            nextTick = std::chrono::steady_clock::now();
+            continue;
+        }
+        isIdle_ = false;
+        lock.unlock();
+        tick();
+        lock.lock();
+        // Fixed tick, if the tick took too long continue from now instead of trying to catch up
+        nextTick += tickDuration;
+        auto now = std::chrono::steady_clock::now();
+        if (nextTick < now) {
+            nextTick = now;
+        }
+        condition_.wait_until(lock, nextTick, [this] { return !isRunning_ || isQuitting_; });
+    }
+    isIdle_ = true;
+    condition_.notify_all();
+}
+
+void PhysicsThread::tick() {
+    TRACE_ZONE("PhysicsThread::tick");
+    ALLOC_TAG("Physics");
+    WorldCommand command;
+    while (commands_.pop(command)) {
+        world_.applyCommand(command);
+    }
+    world_.tick();
+    world_.captureSnapshot(snapshots_.back());
+    snapshots_.publish();
+}
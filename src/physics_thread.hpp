@@ -0,0 +1,44 @@
+#ifndef PHYSICS_THREAD_HPP
+#define PHYSICS_THREAD_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "world.hpp"
+#include "triple_buffer.hpp"
+
+/**
+ * @brief Steps the World on its own thread at a fixed tick
+ *
+ * While running, the physics thread owns the Box2D world and the level objects. The main thread sends input
+ * through a lock-free command queue and draws the latest snapshot from a triple buffer, so neither thread waits for the other.
+ * The main thread must pause the thread before touching the world directly, e.g. when loading a level or handling the level end,
+ * and refresh the snapshot afterwards.
+ */
+class PhysicsThread {
+    public:
+        PhysicsThread(World& world);
+        ~PhysicsThread();
+        PhysicsThread(const PhysicsThread&) = delete;
+        PhysicsThread& operator=(const PhysicsThread&) = delete;
+        void resume();
+        void pause();
+        bool pushCommand(const WorldCommand& command);
+        bool updateSnapshot();
+        const WorldSnapshot& getSnapshot() const;
+        void refreshSnapshot();
+    private:
+        World& world_;
+        TripleBuffer<WorldSnapshot> snapshots_;
+        SpscQueue<WorldCommand, 256> commands_;
+        std::mutex mutex_; // Guards the flags below, only locked when pausing and between ticks
+        std::condition_variable condition_;
+        bool isRunning_ = false;
+        bool isIdle_ = true;
+        bool isQuitting_ = false;
+        std::thread thread_;
+        void run();
+        void tick();
+};
+
+#endif // PHYSICS_THREAD_HPP
@@ -3,15 +3,16 @@
 
 #include "object.hpp"
 
+const std::string PIG_TEXTURE = "/assets/images/pig.png";
 const int PIG_DESTRUCTION_SCORE = 1000;
+const float PIG_HEALTH = 100.f;
 
 class Pig : public Object {
     public:
-        Pig(b2Body *body, float radius);
+        Pig(b2Body *body, float radius, const sf::Texture& texture);
         virtual char getTypeAsChar() const override;
         virtual int getDestructionScore() const override;
         virtual bool shouldRemove() const override;
-        virtual void handleCollision(Object* objectB) override;
 };
 
 #endif //PIG_HPP
\ No newline at end of file
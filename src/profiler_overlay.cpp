@@ -0,0 +1,149 @@
+#include "profiler_overlay.hpp"
+#include "resource_manager.hpp"
+#include "utils.hpp"
+#include "alloc_tracker.hpp"
+#include "startup_profiler.hpp"
+#include <iomanip>
+#include <sstream>
+
+const sf::Vector2f OVERLAY_POSITION(10.f, 80.f);
+const float GRAPH_HEIGHT = 120.f; // Pixels
+const float GRAPH_SCALE = GRAPH_HEIGHT / 33.3f; // Pixels per millisecond, two frames fit in the graph
+const int TEXT_UPDATE_INTERVAL = 15; // Frames between text updates
+
+namespace {
+    using Phase = FrameProfiler::Phase;
+
+    // Leaf phases of the game loop, stacked in this order in the graph
+    const std::array<Phase, 8> GRAPH_PHASES = {
+        Phase::Events, Phase::Step, Phase::Collisions, Phase::ObjectState,
+        Phase::BirdState, Phase::Camera, Phase::HUD, Phase::Render
+    };
+    const std::array<sf::Color, 8> GRAPH_COLORS = {
+        sf::Color(255, 200, 0), sf::Color(0, 160, 255), sf::Color(120, 220, 255), sf::Color(0, 255, 160),
+        sf::Color(0, 190, 90), sf::Color(255, 120, 200), sf::Color(200, 120, 255), sf::Color(255, 80, 60)
+    };
+    // Phases listed in the text with their percentiles
+    const std::array<Phase, 10> TEXT_PHASES = {
+        Phase::Frame, Phase::Events, Phase::Update, Phase::Step, Phase::Collisions,
+        Phase::ObjectState, Phase::BirdState, Phase::Camera, Phase::HUD, Phase::Render
+    };
+}
+
+ProfilerOverlay::ProfilerOverlay() :
+    graph_(sf::Lines, PROFILER_HISTORY * GRAPH_PHASES.size() * 2),
+    legend_(sf::Quads, GRAPH_PHASES.size() * 4),
+    budgetLine_(sf::Lines, 2) {
+    background_.setPosition(OVERLAY_POSITION);
+    background_.setSize(sf::Vector2f(PROFILER_HISTORY + 380.f, GRAPH_HEIGHT + 260.f));
+    background_.setFillColor(sf::Color(0, 0, 0, 180));
+
+    float graphBottom = OVERLAY_POSITION.y + 10.f + GRAPH_HEIGHT;
+    float budgetY = graphBottom - TIME_STEP * 1000.f * GRAPH_SCALE;
+    budgetLine_[0] = sf::Vertex(sf::Vector2f(OVERLAY_POSITION.x + 10.f, budgetY), sf::Color::White);
+    budgetLine_[1] = sf::Vertex(sf::Vector2f(OVERLAY_POSITION.x + 10.f + PROFILER_HISTORY, budgetY), sf::Color::White);
+
+    // Legend below the graph, one phase per row
+    sf::Font& font = ResourceManager::getInstance().getFont("/assets/fonts/BerkshireSwash-Regular.ttf");
+    for (size_t i = 0; i < GRAPH_PHASES.size(); i++) {
+        sf::Vector2f corner(OVERLAY_POSITION.x + 10.f, graphBottom + 12.f + i * 24.f);
+        legend_[i * 4] = sf::Vertex(corner, GRAPH_COLORS[i]);
+        legend_[i * 4 + 1] = sf::Vertex(corner + sf::Vector2f(14.f, 0), GRAPH_COLORS[i]);
+        legend_[i * 4 + 2] = sf::Vertex(corner + sf::Vector2f(14.f, 14.f), GRAPH_COLORS[i]);
+        legend_[i * 4 + 3] = sf::Vertex(corner + sf::Vector2f(0, 14.f), GRAPH_COLORS[i]);
+        legendLabels_[i].setFont(font);
+        legendLabels_[i].setCharacterSize(14);
+        legendLabels_[i].setFillColor(sf::Color::White);
+        legendLabels_[i].setString(FrameProfiler::getPhaseName(GRAPH_PHASES[i]));
+        legendLabels_[i].setPosition(corner.x + 20.f, corner.y - 3.f);
+    }
+
+    // Percentiles and Box2D numbers on the right side of the graph
+    statsText_.setFont(font);
+    statsText_.setCharacterSize(14);
+    statsText_.setFillColor(sf::Color::White);
+    statsText_.setPosition(OVERLAY_POSITION.x + PROFILER_HISTORY + 30.f, OVERLAY_POSITION.y + 10.f);
+}
+
+void ProfilerOverlay::update() {
+    if (!FrameProfiler::getInstance().isEnabled()) {
+        return;
+    }
+    updateGraph();
+    if (framesUntilTextUpdate_-- <= 0) {
+        framesUntilTextUpdate_ = TEXT_UPDATE_INTERVAL;
+        updateText();
+    }
+}
+
+// Newest frame on the right, each frame is a column of stacked phase segments
+void ProfilerOverlay::updateGraph() {
+    const FrameProfiler& profiler = FrameProfiler::getInstance();
+    int frameCount = profiler.getFrameCount();
+    float graphBottom = OVERLAY_POSITION.y + 10.f + GRAPH_HEIGHT;
+    for (int frame = 0; frame < PROFILER_HISTORY; frame++) {
+        float x = OVERLAY_POSITION.x + 10.f + PROFILER_HISTORY - frame;
+        float y = graphBottom;
+        for (size_t i = 0; i < GRAPH_PHASES.size(); i++) {
+            float height = frame < frameCount ? profiler.getSample(GRAPH_PHASES[i], frame) * GRAPH_SCALE : 0;
+            // Clamp to the top of the graph so spikes don't cover the text
+            float top = std::max(y - height, OVERLAY_POSITION.y + 10.f);
+            size_t index = (frame * GRAPH_PHASES.size() + i) * 2;
+            graph_[index] = sf::Vertex(sf::Vector2f(x, y), GRAPH_COLORS[i]);
+            graph_[index + 1] = sf::Vertex(sf::Vector2f(x, top), GRAPH_COLORS[i]);
+            y = top;
+        }
+    }
+}
+
+void ProfilerOverlay::updateText() {
+    ALLOC_TAG_UNCHECKED("ProfilerOverlay");
+    const FrameProfiler& profiler = FrameProfiler::getInstance();
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    oss << std::left << std::setw(16) << "ms" << "last    p50    p95    p99\n";
+    for (Phase phase : TEXT_PHASES) {
+        PhaseStats stats = profiler.getStats(phase);
+        oss << std::setw(16) << FrameProfiler::getPhaseName(phase)
+            << stats.last << "   " << stats.p50 << "   " << stats.p95 << "   " << stats.p99 << "\n";
+    }
+    const PhysicsStats& physics = profiler.getPhysicsStats();
+    oss << "Box2D step " << physics.step << "  collide " << physics.collide
+        << "  solve " << physics.solve << "  broadphase " << physics.broadphase << "\n";
+    oss << "Bodies " << physics.bodyCount << "  awake " << physics.awakeBodyCount
+        << "  frozen " << physics.frozenBodyCount << "  contacts " << physics.contactCount;
+    PhaseStats latency = profiler.getInputLatencyStats();
+    oss << "\nInput to present " << latency.last << "  p50 " << latency.p50 << "  p95 " << latency.p95 << "  p99 " << latency.p99;
+    oss << "\nStartup " << StartupProfiler::getInstance().getTimeToFirstFrame() << " ms to first frame";
+    const AllocationTracker& tracker = AllocationTracker::getInstance();
+    if (AllocationTracker::isCompiledIn()) {
+        const AllocationStats& allocations = tracker.getFrameStats();
+        oss << "\nAllocs " << allocations.count << "  bytes " << allocations.bytes << "  frees " << allocations.frees << "\n";
+        for (size_t i = 0; i < tracker.getTagCount(); i++) {
+            const TagStats& tag = tracker.getTagStats(i);
+            if (tag.stats.count > 0) {
+                oss << tag.name << " " << tag.stats.count << "  ";
+            }
+        }
+    }
+    statsText_.setString(oss.str());
+}
+
+void ProfilerOverlay::draw(RenderQueue& window) const {
+    if (!FrameProfiler::getInstance().isEnabled()) {
+        return;
+    }
+    // Draw in screen coordinates so the overlay doesn't move with the camera
+    sf::View currentView = window.getView();
+    sf::Vector2u size = window.getSize();
+    window.setView(sf::View(sf::FloatRect(0, 0, size.x, size.y)));
+    window.draw(background_);
+    window.draw(graph_);
+    window.draw(budgetLine_);
+    window.draw(legend_);
+    for (const auto& label : legendLabels_) {
+        window.draw(label);
+    }
+    window.draw(statsText_);
+    window.setView(currentView);
+}
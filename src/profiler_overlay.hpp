@@ -0,0 +1,32 @@
+#ifndef PROFILER_OVERLAY_HPP
+#define PROFILER_OVERLAY_HPP
+
+#include <SFML/Graphics.hpp>
+#include "render_queue.hpp"
+#include "frame_profiler.hpp"
+
+/**
+ * @brief Overlay that shows the FrameProfiler data on top of the game, toggled with F3
+ *
+ * Draws a stacked graph of the phase timings of the last PROFILER_HISTORY frames, percentiles of each phase,
+ * the Box2D profile of the latest step and, when allocation tracking is compiled in, the allocations of the previous frame.
+ * Vertex arrays are sized once, so updating the graph doesn't allocate.
+ */
+class ProfilerOverlay {
+    public:
+        ProfilerOverlay();
+        void update();
+        void draw(RenderQueue& window) const;
+    private:
+        sf::RectangleShape background_;
+        sf::VertexArray graph_; // One vertical line segment per phase per frame
+        sf::VertexArray legend_; // One colored square per graphed phase
+        std::array<sf::Text, 8> legendLabels_;
+        sf::VertexArray budgetLine_; // Frame time budget of TIME_STEP
+        sf::Text statsText_;
+        int framesUntilTextUpdate_ = 0;
+        void updateGraph();
+        void updateText();
+};
+
+#endif // PROFILER_OVERLAY_HPP
@@ -0,0 +1,72 @@
+#include "render_layer.hpp"
+#include <cmath>
+
+namespace {
+    sf::FloatRect getViewRect(const sf::View& view) {
+        sf::Vector2f size = view.getSize();
+        return sf::FloatRect(view.getCenter() - size / 2.f, size);
+    }
+
+    bool contains(const sf::FloatRect& outer, const sf::FloatRect& inner) {
+        return inner.left >= outer.left && inner.top >= outer.top
+            && inner.left + inner.width <= outer.left + outer.width
+            && inner.top + inner.height <= outer.top + outer.height;
+    }
+}
+
+// Whether the cached texture can be drawn for the view, rotated views are never cached
+bool RenderLayer::isValid(uint64_t key, const sf::View& view, const sf::Vector2u& targetSize) const {
+    return isCached_ && key == key_ && view.getSize() == viewSize_ && targetSize == targetSize_
+        && view.getRotation() == 0 && contains(area_, getViewRect(view));
+}
+
+// Prepares the texture for rendering the content around the view, returns false if the layer can't be cached
+bool RenderLayer::begin(uint64_t key, const sf::View& view, const sf::Vector2u& targetSize) {
+    isCached_ = false;
+    sf::Vector2f viewSize = view.getSize();
+    if (view.getRotation() != 0 || viewSize.x <= 0 || viewSize.y <= 0) {
+        return false;
+    }
+    // Target pixels per world unit, the area is aligned to whole pixels so the cached texture is sampled 1:1
+    sf::Vector2f scale(targetSize.x / viewSize.x, targetSize.y / viewSize.y);
+    sf::FloatRect viewRect = getViewRect(view);
+    sf::Vector2f margin = viewSize * LAYER_MARGIN;
+    float left = std::floor((viewRect.left - margin.x) * scale.x) / scale.x;
+    float top = std::floor((viewRect.top - margin.y) * scale.y) / scale.y;
+    unsigned int width = static_cast<unsigned int>(std::ceil((viewSize.x + 2 * margin.x) * scale.x)) + 1;
+    unsigned int height = static_cast<unsigned int>(std::ceil((viewSize.y + 2 * margin.y) * scale.y)) + 1;
+    unsigned int maximumSize = sf::Texture::getMaximumSize();
+    if (width > maximumSize || height > maximumSize) {
+        return false;
+    }
+    sf::Vector2u size = texture_.getSize();
+    if ((size.x != width || size.y != height) && !texture_.create(width, height)) {
+        return false;
+    }
+    area_ = sf::FloatRect(left, top, width / scale.x, height / scale.y);
+    texture_.setView(sf::View(area_));
+    texture_.clear(sf::Color::Transparent);
+    viewSize_ = viewSize;
+    targetSize_ = targetSize;
+    key_ = key;
+    isCached_ = true;
+    return true;
+}
+
+sf::RenderTexture& RenderLayer::getTexture() {
+    return texture_;
+}
+
+// Draws the cached area with the current view of the target
+void RenderLayer::draw(sf::RenderTarget& target) const {
+    sf::Sprite sprite(texture_.getTexture());
+    sprite.setPosition(area_.left, area_.top);
+    sprite.setScale(area_.width / texture_.getSize().x, area_.height / texture_.getSize().y);
+    // The texture was cleared to transparent and drawn into with alpha blending, so its colors are already multiplied by alpha.
+    // Blended as premultiplied, so soft edges don't get dark fringes and the clear color shows where the layer has no content
+    target.draw(sprite, sf::RenderStates(sf::BlendMode(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha)));
+}
+
+void RenderLayer::invalidate() {
+    isCached_ = false;
+}
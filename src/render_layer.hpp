@@ -0,0 +1,32 @@
+#ifndef RENDER_LAYER_HPP
+#define RENDER_LAYER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+const float LAYER_MARGIN = 0.125f; // Extra area rendered around the view on each side, as a fraction of the view size
+
+/**
+ * @brief Cached render texture of a layer of the frame that rarely changes, only used by the render thread
+ *
+ * The layer covers the view plus LAYER_MARGIN on each side. It is re-rendered when the key of its content changes,
+ * the scale of the view changes or the view moves past the margin, otherwise the cached texture is drawn as one quad.
+ * If the texture would be larger than the GPU supports, the layer isn't cached and its content is drawn directly.
+ */
+class RenderLayer {
+    public:
+        bool isValid(uint64_t key, const sf::View& view, const sf::Vector2u& targetSize) const;
+        bool begin(uint64_t key, const sf::View& view, const sf::Vector2u& targetSize);
+        sf::RenderTexture& getTexture();
+        void draw(sf::RenderTarget& target) const;
+        void invalidate();
+    private:
+        sf::RenderTexture texture_;
+        sf::FloatRect area_; // World area covered by the texture
+        sf::Vector2f viewSize_; // Size of the view the layer was rendered for
+        sf::Vector2u targetSize_;
+        uint64_t key_ = 0;
+        bool isCached_ = false;
+};
+
+#endif // RENDER_LAYER_HPP
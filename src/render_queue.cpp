@@ -0,0 +1,321 @@
+#include "render_queue.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Primitives whose vertices don't depend on the previous ones can be merged into one draw call
+    bool isMergeable(sf::PrimitiveType primitive) {
+        return primitive == sf::Quads || primitive == sf::Triangles || primitive == sf::Lines || primitive == sf::Points;
+    }
+
+    // Same shear SFML uses for italic text, 12 degrees
+    const float ITALIC_SHEAR = 0.209f;
+}
+
+// Starts a new frame with the target's current view and size
+void RenderQueue::reset(const sf::RenderTarget& target) {
+    commands_.clear();
+    vertices_.clear();
+    views_.clear();
+    glyphTextures_.clear();
+    hasInputTime_ = false;
+    isLayerOpen_ = false;
+    size_ = target.getSize();
+    setView(target.getView());
+}
+
+void RenderQueue::clear(const sf::Color& color) {
+    RenderCommand command;
+    command.type = RenderCommand::Type::Clear;
+    command.color = color;
+    commands_.push_back(command);
+}
+
+void RenderQueue::setView(const sf::View& view) {
+    view_ = view;
+    RenderCommand command;
+    command.type = RenderCommand::Type::View;
+    command.first = views_.size();
+    views_.push_back(view);
+    commands_.push_back(command);
+}
+
+const sf::View& RenderQueue::getView() const {
+    return view_;
+}
+
+sf::Vector2u RenderQueue::getSize() const {
+    return size_;
+}
+
+void RenderQueue::draw(const sf::Sprite& sprite) {
+    const sf::Texture* texture = sprite.getTexture();
+    if (texture == nullptr) {
+        return; // SFML doesn't draw sprites without a texture either
+    }
+    sf::IntRect textureRect = sprite.getTextureRect();
+    sf::FloatRect rect(0, 0, std::abs(textureRect.width), std::abs(textureRect.height));
+    getVertexCommand(sf::Quads, texture);
+    addQuad(sprite.getTransform(), rect, sf::FloatRect(textureRect), sprite.getColor());
+}
+
+void RenderQueue::draw(const sf::RectangleShape& shape) {
+    const sf::Transform& transform = shape.getTransform();
+    sf::Vector2f size = shape.getSize();
+    sf::FloatRect rect(0, 0, size.x, size.y);
+    if (shape.getTexture() != nullptr || shape.getFillColor().a > 0) {
+        getVertexCommand(sf::Quads, shape.getTexture());
+        addQuad(transform, rect, sf::FloatRect(shape.getTextureRect()), shape.getFillColor());
+    }
+    float thickness = shape.getOutlineThickness();
+    if (thickness == 0 || shape.getOutlineColor().a == 0) {
+        return;
+    }
+    // The outline grows outwards with a positive thickness and inwards with a negative one
+    sf::FloatRect offset(-thickness, -thickness, size.x + 2 * thickness, size.y + 2 * thickness);
+    const sf::FloatRect& outer = thickness > 0 ? offset : rect;
+    const sf::FloatRect& inner = thickness > 0 ? rect : offset;
+    float outerRight = outer.left + outer.width;
+    float outerBottom = outer.top + outer.height;
+    float innerRight = inner.left + inner.width;
+    float innerBottom = inner.top + inner.height;
+    const sf::Color& color = shape.getOutlineColor();
+    getVertexCommand(sf::Quads, nullptr);
+    addQuad(transform, sf::FloatRect(outer.left, outer.top, outer.width, inner.top - outer.top), sf::FloatRect(), color);
+    addQuad(transform, sf::FloatRect(outer.left, innerBottom, outer.width, outerBottom - innerBottom), sf::FloatRect(), color);
+    addQuad(transform, sf::FloatRect(outer.left, inner.top, inner.left - outer.left, inner.height), sf::FloatRect(), color);
+    addQuad(transform, sf::FloatRect(innerRight, inner.top, outerRight - innerRight, inner.height), sf::FloatRect(), color);
+}
+
+void RenderQueue::draw(const sf::Text& text) {
+    if (text.getFont() == nullptr || text.getString().isEmpty()) {
+        return;
+    }
+    // Outlines are drawn under the whole text like SFML does
+    if (text.getOutlineThickness() != 0) {
+        addGlyphs(text, text.getOutlineThickness(), text.getOutlineColor());
+    }
+    addGlyphs(text, 0, text.getFillColor());
+}
+
+void RenderQueue::draw(const sf::VertexArray& vertices) {
+    size_t count = vertices.getVertexCount();
+    if (count == 0) {
+        return;
+    }
+    RenderCommand& command = getVertexCommand(vertices.getPrimitiveType(), nullptr);
+    for (size_t i = 0; i < count; i++) {
+        vertices_.push_back(vertices[i]);
+    }
+    command.count += count;
+}
+
+// Vertices in local coordinates, e.g. the cached glyph quads of a HudText
+void RenderQueue::draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType primitive, const sf::Texture* texture, const sf::Transform& transform) {
+    if (count == 0) {
+        return;
+    }
+    RenderCommand& command = getVertexCommand(primitive, texture);
+    for (size_t i = 0; i < count; i++) {
+        const sf::Vertex& vertex = vertices[i];
+        vertices_.emplace_back(transform.transformPoint(vertex.position), vertex.color, vertex.texCoords);
+    }
+    command.count += count;
+}
+
+// Starts a layer drawn with the current view, layers can't be nested
+void RenderQueue::beginLayer(uint64_t key) {
+    RenderCommand command;
+    command.type = RenderCommand::Type::LayerBegin;
+    command.key = key;
+    layerBegin_ = commands_.size();
+    isLayerOpen_ = true;
+    commands_.push_back(command);
+}
+
+void RenderQueue::endLayer() {
+    if (!isLayerOpen_) {
+        return;
+    }
+    commands_[layerBegin_].first = commands_.size();
+    isLayerOpen_ = false;
+    RenderCommand command;
+    command.type = RenderCommand::Type::LayerEnd;
+    commands_.push_back(command);
+}
+
+// Layers are drawn from the cache when one is given, otherwise their commands are replayed like the others
+void RenderQueue::replay(sf::RenderTarget& target, RenderLayer* layer) const {
+    for (size_t i = 0; i < commands_.size(); i++) {
+        const RenderCommand& command = commands_[i];
+        if (command.type != RenderCommand::Type::LayerBegin || layer == nullptr || command.first <= i) {
+            replayCommand(target, command);
+            continue;
+        }
+        const sf::View& view = target.getView();
+        if (!layer->isValid(command.key, view, target.getSize())) {
+            if (!layer->begin(command.key, view, target.getSize())) {
+                continue; // Not cached, the commands of the layer are replayed directly
+            }
+            sf::RenderTexture& texture = layer->getTexture();
+            for (size_t j = i + 1; j < command.first; j++) {
+                // The layer texture keeps the view of its area
+                if (commands_[j].type != RenderCommand::Type::View) {
+                    replayCommand(texture, commands_[j]);
+                }
+            }
+            texture.display();
+        }
+        layer->draw(target);
+        i = command.first;
+    }
+}
+
+void RenderQueue::replayCommand(sf::RenderTarget& target, const RenderCommand& command) const {
+    switch (command.type) {
+        case RenderCommand::Type::Clear:
+            target.clear(command.color);
+            break;
+        case RenderCommand::Type::View:
+            target.setView(views_[command.first]);
+            break;
+        case RenderCommand::Type::Vertices:
+            target.draw(&vertices_[command.first], command.count, command.primitive, sf::RenderStates(command.texture));
+            break;
+        default:
+            break;
+    }
+}
+
+size_t RenderQueue::getCommandCount() const {
+    return commands_.size();
+}
+
+// Returns the last command if the new vertices can be appended to it, otherwise starts a new command
+RenderCommand& RenderQueue::getVertexCommand(sf::PrimitiveType primitive, const sf::Texture* texture) {
+    if (!commands_.empty()) {
+        RenderCommand& last = commands_.back();
+        if (last.type == RenderCommand::Type::Vertices && last.primitive == primitive && last.texture == texture && isMergeable(primitive)) {
+            return last;
+        }
+    }
+    RenderCommand command;
+    command.type = RenderCommand::Type::Vertices;
+    command.primitive = primitive;
+    command.texture = texture;
+    command.first = vertices_.size();
+    commands_.push_back(command);
+    return commands_.back();
+}
+
+// Appends a quad to the last vertex command
+void RenderQueue::addQuad(const sf::Transform& transform, const sf::FloatRect& rect, const sf::FloatRect& textureRect, const sf::Color& color) {
+    float right = rect.left + rect.width;
+    float bottom = rect.top + rect.height;
+    float textureRight = textureRect.left + textureRect.width;
+    float textureBottom = textureRect.top + textureRect.height;
+    vertices_.emplace_back(transform.transformPoint(rect.left, rect.top), color, sf::Vector2f(textureRect.left, textureRect.top));
+    vertices_.emplace_back(transform.transformPoint(right, rect.top), color, sf::Vector2f(textureRight, textureRect.top));
+    vertices_.emplace_back(transform.transformPoint(right, bottom), color, sf::Vector2f(textureRight, textureBottom));
+    vertices_.emplace_back(transform.transformPoint(rect.left, bottom), color, sf::Vector2f(textureRect.left, textureBottom));
+    commands_.back().count += 4;
+}
+
+// Lays out the glyphs the same way sf::Text does, underline and strike through styles aren't used by the game
+void RenderQueue::addGlyphs(const sf::Text& text, float outlineThickness, const sf::Color& color) {
+    const sf::Font& font = *text.getFont();
+    const sf::String& string = text.getString();
+    unsigned int characterSize = text.getCharacterSize();
+    bool isBold = text.getStyle() & sf::Text::Bold;
+    float shear = (text.getStyle() & sf::Text::Italic) ? ITALIC_SHEAR : 0.f;
+    float whitespaceWidth = font.getGlyph(L' ', characterSize, isBold).advance;
+    float letterSpacing = (whitespaceWidth / 3.f) * (text.getLetterSpacing() - 1.f);
+    whitespaceWidth += letterSpacing;
+    float lineSpacing = font.getLineSpacing(characterSize) * text.getLineSpacing();
+    const sf::Transform& transform = text.getTransform();
+
+    // Glyphs are loaded before the page is copied, loading may change the font's texture
+    GlyphPage& page = GlyphPage::get(font, characterSize);
+    size_t first = vertices_.size();
+    float x = 0.f;
+    float y = static_cast<float>(characterSize);
+    sf::Uint32 previous = 0;
+    for (size_t i = 0; i < string.getSize(); i++) {
+        sf::Uint32 current = string[i];
+        if (current == L'\r') {
+            continue;
+        }
+        x += font.getKerning(previous, current, characterSize, isBold);
+        previous = current;
+        if (current == L' ') {
+            x += whitespaceWidth;
+            continue;
+        } else if (current == L'\t') {
+            x += whitespaceWidth * 4;
+            continue;
+        } else if (current == L'\n') {
+            y += lineSpacing;
+            x = 0;
+            continue;
+        }
+        const sf::Glyph& glyph = font.getGlyph(current, characterSize, isBold, outlineThickness);
+        page.addGlyph(current, isBold, outlineThickness);
+        float padding = 1.f;
+        float left = glyph.bounds.left - padding;
+        float top = glyph.bounds.top - padding;
+        float right = glyph.bounds.left + glyph.bounds.width + padding;
+        float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+        float u1 = glyph.textureRect.left - padding;
+        float v1 = glyph.textureRect.top - padding;
+        float u2 = glyph.textureRect.left + glyph.textureRect.width + padding;
+        float v2 = glyph.textureRect.top + glyph.textureRect.height + padding;
+        vertices_.emplace_back(transform.transformPoint(x + left - shear * top, y + top), color, sf::Vector2f(u1, v1));
+        vertices_.emplace_back(transform.transformPoint(x + right - shear * top, y + top), color, sf::Vector2f(u2, v1));
+        vertices_.emplace_back(transform.transformPoint(x + right - shear * bottom, y + bottom), color, sf::Vector2f(u2, v2));
+        vertices_.emplace_back(transform.transformPoint(x + left - shear * bottom, y + bottom), color, sf::Vector2f(u1, v2));
+        // The fill glyph's advance is used for the outline too, so both passes line up
+        x += font.getGlyph(current, characterSize, isBold).advance + letterSpacing;
+    }
+    size_t count = vertices_.size() - first;
+    if (count == 0) {
+        return;
+    }
+    const sf::Texture* texture = useGlyphPage(page);
+    if (!commands_.empty()) {
+        RenderCommand& last = commands_.back();
+        if (last.type == RenderCommand::Type::Vertices && last.primitive == sf::Quads && last.texture == texture
+            && last.first + last.count == first) {
+            last.count += count;
+            return;
+        }
+    }
+    RenderCommand command;
+    command.type = RenderCommand::Type::Vertices;
+    command.primitive = sf::Quads;
+    command.texture = texture;
+    command.first = first;
+    command.count = count;
+    commands_.push_back(command);
+}
+
+// Keeps the current copy of the page alive while the frame is in flight, called after the frame's glyphs are added to the page
+const sf::Texture* RenderQueue::useGlyphPage(GlyphPage& page) {
+    const std::shared_ptr<const sf::Texture>& texture = page.getTexture();
+    if (std::find(glyphTextures_.begin(), glyphTextures_.end(), texture) == glyphTextures_.end()) {
+        glyphTextures_.push_back(texture);
+    }
+    return texture.get();
+}
+
+void RenderQueue::setInputTime(std::chrono::steady_clock::time_point time) {
+    inputTime_ = time;
+    hasInputTime_ = true;
+}
+
+bool RenderQueue::hasInputTime() const {
+    return hasInputTime_;
+}
+
+std::chrono::steady_clock::time_point RenderQueue::getInputTime() const {
+    return inputTime_;
+}
@@ -0,0 +1,88 @@
+#ifndef RENDER_QUEUE_HPP
+#define RENDER_QUEUE_HPP
+
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "glyph_page.hpp"
+#include "render_layer.hpp"
+
+/**
+ * @brief A single recorded draw command
+ *
+ * @param type Clear the target, set the view, draw vertices or mark the beginning or end of a cached layer
+ * @param primitive Primitive type of the vertices
+ * @param texture Texture of the vertices, nullptr for untextured vertices
+ * @param first Index of the first vertex, the index of the view for view commands or the index of the layer end for layer commands
+ * @param count Number of vertices
+ * @param color Clear color
+ * @param key Content key of the layer, the cached layer is reused while the key stays the same
+ */
+struct RenderCommand {
+    enum class Type {
+        Clear,
+        View,
+        Vertices,
+        LayerBegin,
+        LayerEnd,
+    };
+    Type type;
+    sf::PrimitiveType primitive = sf::Quads;
+    const sf::Texture* texture = nullptr;
+    size_t first = 0;
+    size_t count = 0;
+    sf::Color color;
+    uint64_t key = 0;
+};
+
+/**
+ * @brief Per-frame buffer of draw commands recorded on the main thread and replayed on the render thread
+ *
+ * Sprites, rectangle shapes and texts are recorded as pre-transformed quads, so replaying a frame doesn't touch
+ * the objects that recorded it. Consecutive quads with the same texture are merged into one draw call.
+ * Text glyphs are looked up while recording, so fonts are only used from the main thread. Glyph quads sample
+ * a GlyphPage copy of the font's texture, which the queue keeps alive until it is recorded again.
+ * Buffers are reused between frames, so recording doesn't allocate once they have grown to the frame's size.
+ * Commands between beginLayer and endLayer form a layer that the render thread caches in a RenderLayer,
+ * they are only replayed again when the key of the layer changes or the view moves past the cached area.
+ */
+class RenderQueue {
+    public:
+        void reset(const sf::RenderTarget& target);
+        void clear(const sf::Color& color);
+        void setView(const sf::View& view);
+        const sf::View& getView() const;
+        sf::Vector2u getSize() const;
+        void draw(const sf::Sprite& sprite);
+        void draw(const sf::RectangleShape& shape);
+        void draw(const sf::Text& text);
+        void draw(const sf::VertexArray& vertices);
+        void draw(const sf::Vertex* vertices, size_t count, sf::PrimitiveType primitive, const sf::Texture* texture, const sf::Transform& transform);
+        void beginLayer(uint64_t key);
+        void endLayer();
+        void replay(sf::RenderTarget& target, RenderLayer* layer = nullptr) const;
+        size_t getCommandCount() const;
+        void setInputTime(std::chrono::steady_clock::time_point time);
+        bool hasInputTime() const;
+        std::chrono::steady_clock::time_point getInputTime() const;
+        const sf::Texture* useGlyphPage(GlyphPage& page);
+    private:
+        std::vector<RenderCommand> commands_;
+        std::vector<sf::Vertex> vertices_;
+        std::vector<sf::View> views_;
+        std::vector<std::shared_ptr<const sf::Texture>> glyphTextures_; // Glyph page copies sampled by the frame
+        sf::View view_;
+        sf::Vector2u size_;
+        std::chrono::steady_clock::time_point inputTime_; // Time the first input shown by the frame was polled
+        bool hasInputTime_ = false;
+        size_t layerBegin_ = 0; // Index of the open layer's begin command
+        bool isLayerOpen_ = false;
+        void replayCommand(sf::RenderTarget& target, const RenderCommand& command) const;
+        RenderCommand& getVertexCommand(sf::PrimitiveType primitive, const sf::Texture* texture);
+        void addQuad(const sf::Transform& transform, const sf::FloatRect& rect, const sf::FloatRect& textureRect, const sf::Color& color);
+        void addGlyphs(const sf::Text& text, float outlineThickness, const sf::Color& color);
+};
+
+#endif // RENDER_QUEUE_HPP
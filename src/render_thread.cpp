@@ -0,0 +1,125 @@
+#include "render_thread.hpp"
+#include "trace.hpp"
+#include "alloc_tracker.hpp"
+#include "startup_profiler.hpp"
+#include "frame_profiler.hpp"
+#include <SFML/OpenGL.hpp>
+
+RenderThread::RenderThread(sf::Window& window) : window_(window) {
+    // The context can only be active in one thread at a time, hand it over to the render thread
+    window_.setActive(false);
+    thread_ = std::thread(&RenderThread::run, this);
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+// Queue for recording the next frame, only used by the main thread
+RenderQueue& RenderThread::getQueue() {
+    return queues_.back();
+}
+
+void RenderThread::submit() {
+    queues_.publish();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        hasFrame_ = true;
+    }
+    condition_.notify_one();
+}
+
+// Blocks until the render thread has copied the last rendered frame
+sf::Image RenderThread::capture() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (isStopped_) {
+        return sf::Image();
+    }
+    isCaptureRequested_ = true;
+    condition_.notify_one();
+    condition_.wait(lock, [this] { return !isCaptureRequested_ || isStopped_; });
+    return capture_;
+}
+
+// Stops the thread, must be called before the window is closed
+void RenderThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (isStopped_) {
+            return;
+        }
+        isStopped_ = true;
+    }
+    condition_.notify_all();
+    thread_.join();
+}
+
+void RenderThread::run() {
+    trace::setThreadName("Render");
+    window_.setActive(true);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this] { return hasFrame_ || isCaptureRequested_ || isStopped_; });
+        if (isStopped_) {
+            break;
+        }
+        if (isCaptureRequested_) {
+            capture_ = frame_.getTexture().copyToImage();
+            isCaptureRequested_ = false;
+            condition_.notify_all();
+            continue;
+        }
+        hasFrame_ = false;
+        lock.unlock();
+        if (queues_.update()) {
+            render(queues_.front());
+        }
+        lock.lock();
+    }
+    window_.setActive(false);
+}
+
+void RenderThread::render(const RenderQueue& queue) {
+    TRACE_ZONE("RenderThread::render");
+    ALLOC_TAG("RenderThread");
+    sf::Vector2u size = queue.getSize();
+    if (frame_.getSize() != size && !frame_.create(size.x, size.y)) {
+        return;
+    }
+    queue.replay(frame_, &layer_);
+    frame_.display();
+    present(size);
+    if (queue.hasInputTime()) {
+        auto latency = std::chrono::steady_clock::now() - queue.getInputTime();
+        FrameProfiler::getInstance().addInputLatency(std::chrono::duration<float, std::milli>(latency).count());
+    }
+}
+
+// Copies the frame texture over the whole window and swaps the buffers
+void RenderThread::present(const sf::Vector2u& size) {
+    window_.setActive(true);
+    glViewport(0, 0, static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y));
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    glDisable(GL_BLEND);
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_TEXTURE_2D);
+    glColor4f(1.f, 1.f, 1.f, 1.f);
+    // Normalized binding also flips the render texture, so (0, 0) is its top left corner
+    sf::Texture::bind(&frame_.getTexture(), sf::Texture::Normalized);
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.f, 0.f);
+    glVertex2f(-1.f, 1.f);
+    glTexCoord2f(1.f, 0.f);
+    glVertex2f(1.f, 1.f);
+    glTexCoord2f(1.f, 1.f);
+    glVertex2f(1.f, -1.f);
+    glTexCoord2f(0.f, 1.f);
+    glVertex2f(-1.f, -1.f);
+    glEnd();
+    sf::Texture::bind(nullptr);
+    window_.display();
+    StartupProfiler::getInstance().finish(); // Only the first call ends the timeline
+}
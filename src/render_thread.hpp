@@ -0,0 +1,49 @@
+#ifndef RENDER_THREAD_HPP
+#define RENDER_THREAD_HPP
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "render_queue.hpp"
+#include "triple_buffer.hpp"
+
+/**
+ * @brief Replays recorded frames on its own thread, which owns the window's GL context
+ *
+ * The main thread records a frame into the back queue and submits it without waiting for the GPU,
+ * the render thread replays the latest submitted frame and displays it. If the render thread falls behind,
+ * older frames are skipped.
+ * Frames are replayed into an offscreen texture that is then copied to the window with plain GL calls,
+ * so the window's view, which the main thread uses for mapping mouse and HUD coordinates, is never touched by this thread.
+ * The same texture is used for screen captures. The layer recorded between RenderQueue::beginLayer and endLayer is cached
+ * in its own texture and only rendered again when it changes.
+ */
+class RenderThread {
+    public:
+        RenderThread(sf::Window& window);
+        ~RenderThread();
+        RenderThread(const RenderThread&) = delete;
+        RenderThread& operator=(const RenderThread&) = delete;
+        RenderQueue& getQueue();
+        void submit();
+        sf::Image capture();
+        void stop();
+    private:
+        sf::Window& window_;
+        TripleBuffer<RenderQueue> queues_;
+        sf::RenderTexture frame_; // Only used by the render thread
+        RenderLayer layer_; // Cached static layer of the frame, only used by the render thread
+        std::mutex mutex_; // Guards the flags below
+        std::condition_variable condition_;
+        bool hasFrame_ = false;
+        bool isCaptureRequested_ = false;
+        bool isStopped_ = false;
+        sf::Image capture_;
+        std::thread thread_;
+        void run();
+        void render(const RenderQueue& queue);
+        void present(const sf::Vector2u& size);
+};
+
+#endif // RENDER_THREAD_HPP
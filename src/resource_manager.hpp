@@ -7,6 +7,8 @@
 #include <string>
 #include <memory>
 #include "utils.hpp"
+#include "trace.hpp"
+#include "texture_importer.hpp"
 
 class ResourceManager {
 public:
@@ -41,12 +43,13 @@ private:
     // Template method to get or load a resource
     template <typename T>
     T& getResource(const std::string& path, std::unordered_map<std::string, std::unique_ptr<T>>& resourceMap) {
+        TRACE_ZONE("ResourceManager::getResource");
         auto it = resourceMap.find(path);
         if (it != resourceMap.end()) {
             return *(it->second);
         } else {
             std::unique_ptr<T> resource = std::make_unique<T>();
-            if (!utils::loadFromFile(*resource, path)) {
+            if (!loadResource(*resource, path)) {
                 throw std::runtime_error("Failed to load resource: " + path);
             }
             T& resourceRef = *resource;
@@ -55,6 +58,16 @@ private:
         }
     }
 
+    template <typename T>
+    static bool loadResource(T& resource, const std::string& path) {
+        return utils::loadFromFile(resource, path);
+    }
+
+    // Textures are downscaled and mipmapped with their import settings
+    static bool loadResource(sf::Texture& texture, const std::string& path) {
+        return TextureImporter::getInstance().load(texture, path);
+    }
+
     // Maps to store resources
     std::unordered_map<std::string, std::unique_ptr<sf::Font>> fonts_;
     std::unordered_map<std::string, std::unique_ptr<sf::Texture>> textures_;
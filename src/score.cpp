@@ -3,12 +3,10 @@
 
 
 Score::Score() {
-    text_.setFont(ResourceManager::getInstance().getFont("/assets/fonts/BerkshireSwash-Regular.ttf"));
-    text_.setCharacterSize(40);
+    text_.setFont(ResourceManager::getInstance().getFont("/assets/fonts/BerkshireSwash-Regular.ttf"), 40);
     text_.setFillColor(sf::Color::White);
-    text_.setOutlineColor(sf::Color::Black);
-    text_.setOutlineThickness(2);
-    text_.setString("Score: 0 High Score: " + std::to_string(highScore_));
+    text_.setOutline(sf::Color::Black, 2);
+    updateText();
     sf::FloatRect textBounds = text_.getGlobalBounds();
     float xPosition = VIEW.getWidth() - textBounds.width - 20;
     text_.setPosition(xPosition, 10);
@@ -29,18 +27,23 @@ void Score::setPosition(const sf::Vector2f& position) {
 
 void Score::update(int score) {
     currentScore_ += score;
-    text_.setString("Score: " + std::to_string(currentScore_) + " High Score: " + std::to_string(highScore_));
+    updateText();
+}
+
+// Called for each point scored, so the text is formatted without allocating
+void Score::updateText() {
+    text_.format("Score: %d High Score: %d", currentScore_, highScore_);
 }
 
 void Score::reset() {
     currentScore_ = 0;
     stars_ = 0;
     text_.setScale(1.f, 1.f);
-    text_.setString("Score: 0 High Score: " + std::to_string(highScore_));
+    updateText();
 }
 
-void Score::draw(sf::RenderWindow& window) const {
-    window.draw(text_);
+void Score::draw(RenderQueue& window) const {
+    text_.draw(window);
 }
 
 void Score::setHighScores(const std::vector<HighScore>& highScores) {
@@ -49,7 +52,7 @@ void Score::setHighScores(const std::vector<HighScore>& highScores) {
 
 void Score::updateHighScore(int highScore) {
     highScore_ = highScore;
-    text_.setString("Score: " + std::to_string(currentScore_) + " High Score: " + std::to_string(highScore_));
+    updateText();
 }
 
 bool Score::updateHighScores(const HighScore& highScore) {
@@ -80,7 +83,7 @@ void Score::setStars(int stars) {
 }
 
 void Score::setLevelEndText(const std::string& levelName) {
-    text_.setString(levelName + ": Score: " + std::to_string(currentScore_) + " High Score: " + std::to_string(highScore_));
+    text_.format("%s: Score: %d High Score: %d", levelName.c_str(), currentScore_, highScore_);
     text_.setScale(1.2f, 1.2f);
 }
 
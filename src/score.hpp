@@ -2,7 +2,9 @@
 #define SCORE_HPP
 
 #include <SFML/Graphics.hpp>
+#include "render_queue.hpp"
 #include "resource_manager.hpp"
+#include "hud_text.hpp"
 
 struct HighScore {
     std::string player;
@@ -14,7 +16,7 @@ public:
     Score();
     void update(int score);
     void reset();
-    void draw(sf::RenderWindow& window) const;
+    void draw(RenderQueue& window) const;
     void updateHighScore(int highScore);
     bool updateHighScores(const HighScore& highScore);
     void setHighScores(const std::vector<HighScore>& highScores);
@@ -31,7 +33,8 @@ private:
     int highScore_ = 0;
     int stars_ = 0;
     std::vector<HighScore> highScores_;
-    sf::Text text_;
+    HudText text_;
+    void updateText();
 };
 
 #endif // SCORE_HPP
\ No newline at end of file
@@ -14,7 +14,7 @@ void Settings::handleResize() {
     setTitle("Settings", 500.f, 160);
 }
 
-void Settings::draw(sf::RenderWindow& window) const {
+void Settings::draw(RenderQueue& window) const {
     window.draw(background_);
     window.draw(woodenSign_);
     // Draw the title characters
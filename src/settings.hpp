@@ -6,7 +6,7 @@
 class Settings : public Menu {
     public:
         Settings();
-        void draw(sf::RenderWindow& window) const override;
+        void draw(RenderQueue& window) const override;
         void handleResize() override;
     private:
         const std::vector<std::string>& getButtonNames() const override;
@@ -0,0 +1,41 @@
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Fixed size lock-free queue for one producer thread and one consumer thread
+ *
+ * push fails instead of blocking when the queue is full.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue {
+    public:
+        bool push(const T& value) {
+            size_t tail = tail_.load(std::memory_order_relaxed);
+            size_t next = (tail + 1) % Capacity;
+            if (next == head_.load(std::memory_order_acquire)) {
+                return false; // Full
+            }
+            items_[tail] = value;
+            tail_.store(next, std::memory_order_release);
+            return true;
+        }
+        bool pop(T& value) {
+            size_t head = head_.load(std::memory_order_relaxed);
+            if (head == tail_.load(std::memory_order_acquire)) {
+                return false; // Empty
+            }
+            value = items_[head];
+            head_.store((head + 1) % Capacity, std::memory_order_release);
+            return true;
+        }
+    private:
+        std::array<T, Capacity> items_;
+        std::atomic<size_t> head_{0}; // Next item to pop, written by the consumer
+        std::atomic<size_t> tail_{0}; // Next free slot, written by the producer
+};
+
+#endif // SPSC_QUEUE_HPP
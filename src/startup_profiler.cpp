@@ -0,0 +1,58 @@
+#include "startup_profiler.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    // Initialized before main, the closest portable point to process start
+    const std::chrono::steady_clock::time_point PROCESS_START = std::chrono::steady_clock::now();
+
+    float getMillisecondsSinceStart() {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - PROCESS_START).count();
+    }
+}
+
+StartupProfiler& StartupProfiler::getInstance() {
+    static StartupProfiler instance;
+    return instance;
+}
+
+// Marks the end of a startup step, called by the main thread
+void StartupProfiler::mark(const char* name) {
+    if (isFinished() || markCount_ >= STARTUP_MARK_CAPACITY) {
+        return;
+    }
+    marks_[markCount_++] = {name, getMillisecondsSinceStart()};
+}
+
+// Ends the timeline when the first frame has been presented, called by the render thread
+void StartupProfiler::finish() {
+    if (isFinished_.exchange(true)) {
+        return;
+    }
+    timeToFirstFrame_ = getMillisecondsSinceStart();
+    if (std::getenv("AB_STARTUP_PROFILE") != nullptr) {
+        print();
+    }
+}
+
+bool StartupProfiler::isFinished() const {
+    return isFinished_;
+}
+
+// Milliseconds from process start to the first frame presented, 0 until it has been presented
+float StartupProfiler::getTimeToFirstFrame() const {
+    return timeToFirstFrame_;
+}
+
+void StartupProfiler::print() const {
+    std::cout << "Startup timeline (ms since process start)" << std::fixed << std::setprecision(1) << "\n";
+    float previous = 0;
+    for (size_t i = 0; i < markCount_; i++) {
+        std::cout << std::setw(10) << marks_[i].milliseconds << "  +" << std::setw(8) << marks_[i].milliseconds - previous
+            << "  " << marks_[i].name << "\n";
+        previous = marks_[i].milliseconds;
+    }
+    std::cout << std::setw(10) << getTimeToFirstFrame() << "  +" << std::setw(8) << getTimeToFirstFrame() - previous
+        << "  First frame presented" << std::endl;
+}
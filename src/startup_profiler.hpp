@@ -0,0 +1,47 @@
+#ifndef STARTUP_PROFILER_HPP
+#define STARTUP_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+const size_t STARTUP_MARK_CAPACITY = 16; // Further marks are dropped
+
+/**
+ * @brief Mark of the startup timeline
+ *
+ * @param name Name of the step that ended at the mark, must be a string literal
+ * @param milliseconds Time from process start to the mark
+ */
+struct StartupMark {
+    const char* name = nullptr;
+    float milliseconds = 0;
+};
+
+/**
+ * @brief Singleton that measures the time from process start to the first frame presented
+ *
+ * Process start is taken at static initialization. The main thread adds a mark after each startup step, and the render
+ * thread ends the timeline when it presents the first frame. The overlay shows the total, and the timeline is printed
+ * once to stdout when the AB_STARTUP_PROFILE environment variable is set.
+ * The main thread marks happen before the first frame is submitted, so the render thread sees all of them.
+ */
+class StartupProfiler {
+    public:
+        static StartupProfiler& getInstance();
+        StartupProfiler(const StartupProfiler&) = delete;
+        StartupProfiler& operator=(const StartupProfiler&) = delete;
+        void mark(const char* name);
+        void finish();
+        bool isFinished() const;
+        float getTimeToFirstFrame() const;
+    private:
+        StartupProfiler() = default;
+        std::array<StartupMark, STARTUP_MARK_CAPACITY> marks_;
+        size_t markCount_ = 0;
+        std::atomic<float> timeToFirstFrame_{0};
+        std::atomic<bool> isFinished_{false};
+        void print() const;
+};
+
+#endif // STARTUP_PROFILER_HPP
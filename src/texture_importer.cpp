@@ -0,0 +1,114 @@
+#include "texture_importer.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+TextureImporter::TextureImporter() {
+    loadSettings();
+}
+
+TextureImporter& TextureImporter::getInstance() {
+    static TextureImporter instance;
+    return instance;
+}
+
+void TextureImporter::loadSettings() {
+    std::string path = utils::getExecutablePath() + "/assets/data/textures.json";
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file: " + path);
+    }
+    json texturesJson;
+    file >> texturesJson;
+    file.close();
+    for (const auto& [asset, importJson] : texturesJson.at("textures").items()) {
+        TextureImport settings;
+        settings.maxSize = importJson.value("maxSize", settings.maxSize);
+        settings.isMipmapped = importJson.value("mipmap", settings.isMipmapped);
+        settings.isSmooth = importJson.value("smooth", settings.isSmooth);
+        settings_[asset] = settings;
+    }
+}
+
+// Settings of the asset itself, or of its directory
+const TextureImport* TextureImporter::getSettings(const std::string& path) const {
+    auto it = settings_.find(path);
+    if (it != settings_.end()) {
+        return &it->second;
+    }
+    size_t slash = path.find_last_of('/');
+    if (slash != std::string::npos) {
+        it = settings_.find(path.substr(0, slash + 1));
+        if (it != settings_.end()) {
+            return &it->second;
+        }
+    }
+    return nullptr;
+}
+
+bool TextureImporter::load(sf::Texture& texture, const std::string& path) const {
+    const TextureImport* settings = getSettings(path);
+    if (settings == nullptr) {
+        return utils::loadFromFile(texture, path);
+    }
+    sf::Image image;
+    if (!utils::loadFromFile(image, path)) {
+        return false;
+    }
+    sf::Vector2u size = image.getSize();
+    if (settings->maxSize > 0 && std::max(size.x, size.y) > settings->maxSize) {
+        image = downscale(image, settings->maxSize);
+    }
+    if (!texture.loadFromImage(image)) {
+        return false;
+    }
+    texture.setSmooth(settings->isSmooth);
+    if (settings->isMipmapped && !texture.generateMipmap()) {
+        return false;
+    }
+    return true;
+}
+
+// Box filter keeping the aspect ratio, each pixel averages the source pixels it covers.
+// Colors are weighted by alpha so transparent pixels don't darken the edges of sprites
+sf::Image TextureImporter::downscale(const sf::Image& image, unsigned int maxSize) {
+    sf::Vector2u size = image.getSize();
+    float ratio = static_cast<float>(maxSize) / std::max(size.x, size.y);
+    unsigned int width = std::max(1u, static_cast<unsigned int>(std::round(size.x * ratio)));
+    unsigned int height = std::max(1u, static_cast<unsigned int>(std::round(size.y * ratio)));
+    float stepX = static_cast<float>(size.x) / width;
+    float stepY = static_cast<float>(size.y) / height;
+    sf::Image result;
+    result.create(width, height, sf::Color::Transparent);
+    for (unsigned int y = 0; y < height; y++) {
+        unsigned int top = static_cast<unsigned int>(y * stepY);
+        unsigned int bottom = std::min(size.y, std::max(top + 1, static_cast<unsigned int>((y + 1) * stepY)));
+        for (unsigned int x = 0; x < width; x++) {
+            unsigned int left = static_cast<unsigned int>(x * stepX);
+            unsigned int right = std::min(size.x, std::max(left + 1, static_cast<unsigned int>((x + 1) * stepX)));
+            float r = 0, g = 0, b = 0, a = 0;
+            for (unsigned int sourceY = top; sourceY < bottom; sourceY++) {
+                for (unsigned int sourceX = left; sourceX < right; sourceX++) {
+                    sf::Color color = image.getPixel(sourceX, sourceY);
+                    r += color.r * color.a;
+                    g += color.g * color.a;
+                    b += color.b * color.a;
+                    a += color.a;
+                }
+            }
+            if (a > 0) {
+                float count = static_cast<float>((bottom - top) * (right - left));
+                result.setPixel(x, y, sf::Color(
+                    static_cast<sf::Uint8>(std::round(r / a)),
+                    static_cast<sf::Uint8>(std::round(g / a)),
+                    static_cast<sf::Uint8>(std::round(b / a)),
+                    static_cast<sf::Uint8>(std::round(a / count))));
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,42 @@
+#ifndef TEXTURE_IMPORTER_HPP
+#define TEXTURE_IMPORTER_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief Import settings of a texture
+ *
+ * @param maxSize Largest width or height kept, larger images are downscaled at load, 0 keeps the source size
+ * @param isMipmapped Whether mipmaps are generated, for textures drawn smaller than their size
+ * @param isSmooth Whether the texture is sampled with linear filtering
+ */
+struct TextureImport {
+    unsigned int maxSize = 0;
+    bool isMipmapped = false;
+    bool isSmooth = false;
+};
+
+/**
+ * @brief Loads the textures for the ResourceManager with the import settings of assets/data/textures.json
+ *
+ * Settings are looked up by the asset path, a key ending in "/" applies to every asset in that directory.
+ * Assets without settings are loaded as they are. Only textures whose users size them from the texture size,
+ * not with fixed scales or pixel rects, may be downscaled.
+ */
+class TextureImporter {
+    public:
+        static TextureImporter& getInstance();
+        TextureImporter(const TextureImporter&) = delete;
+        TextureImporter& operator=(const TextureImporter&) = delete;
+        bool load(sf::Texture& texture, const std::string& path) const;
+    private:
+        TextureImporter();
+        void loadSettings();
+        const TextureImport* getSettings(const std::string& path) const;
+        static sf::Image downscale(const sf::Image& image, unsigned int maxSize);
+        std::unordered_map<std::string, TextureImport> settings_;
+};
+
+#endif // TEXTURE_IMPORTER_HPP
@@ -0,0 +1,104 @@
+#include "trace.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace trace {
+    namespace {
+        const auto EPOCH = std::chrono::steady_clock::now();
+        std::atomic<ThreadBuffer*> buffers{nullptr}; // Head of the list of all thread buffers
+        std::atomic<int> nextThreadId{0};
+    }
+
+    int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - EPOCH).count();
+    }
+
+    ThreadBuffer::ThreadBuffer(int threadId) : name_("Thread " + std::to_string(threadId)), threadId_(threadId) {}
+
+    void ThreadBuffer::add(const char* name, int64_t start, int64_t duration) {
+        size_t count = count_.load(std::memory_order_relaxed);
+        events_[count % TRACE_BUFFER_SIZE] = {name, start, duration};
+        count_.store(count + 1, std::memory_order_release);
+    }
+
+    void ThreadBuffer::setName(const std::string& name) {
+        std::lock_guard<std::mutex> lock(nameMutex_);
+        name_ = name;
+    }
+
+    ThreadBuffer& getThreadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            buffer = new ThreadBuffer(nextThreadId++);
+            // Push to the front of the list, only the head pointer is shared
+            buffer->next_ = buffers.load(std::memory_order_relaxed);
+            while (!buffers.compare_exchange_weak(buffer->next_, buffer, std::memory_order_release, std::memory_order_relaxed)) {}
+        }
+        return *buffer;
+    }
+
+    // Should be called before the thread records its first zone so the name is visible to the exporter
+    void setThreadName(const std::string& name) {
+        getThreadBuffer().setName(name);
+    }
+
+    Zone::Zone(const char* name) : name_(name), start_(now()) {}
+
+    Zone::~Zone() {
+        getThreadBuffer().add(name_, start_, now() - start_);
+    }
+
+    void exportChromeTrace(const std::string& path) {
+        json events = json::array();
+        std::vector<Event> copied;
+        for (ThreadBuffer* buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next_) {
+            std::string name;
+            {
+                std::lock_guard<std::mutex> lock(buffer->nameMutex_);
+                name = buffer->name_;
+            }
+            events.push_back({
+                {"name", "thread_name"},
+                {"ph", "M"},
+                {"pid", 0},
+                {"tid", buffer->threadId_},
+                {"args", {{"name", name}}}
+            });
+            // Events can be added while exporting, only the ones published before this point are read.
+            // The oldest slots of a full buffer are skipped, they are the next ones the owning thread overwrites
+            size_t count = buffer->count_.load(std::memory_order_acquire);
+            size_t first = count > TRACE_BUFFER_SIZE - TRACE_EXPORT_MARGIN ? count - (TRACE_BUFFER_SIZE - TRACE_EXPORT_MARGIN) : 0;
+            copied.clear();
+            for (size_t i = first; i < count; i++) {
+                copied.push_back(buffer->events_[i % TRACE_BUFFER_SIZE]);
+            }
+            // Events older than a buffer length before the count after the copy may have been overwritten while copying,
+            // including the one the owning thread is writing now
+            std::atomic_thread_fence(std::memory_order_acquire);
+            size_t countAfter = buffer->count_.load(std::memory_order_relaxed);
+            size_t valid = countAfter >= TRACE_BUFFER_SIZE ? countAfter - TRACE_BUFFER_SIZE + 1 : 0;
+            for (size_t i = std::max(first, valid); i < count; i++) {
+                const Event& event = copied[i - first];
+                // Complete events with timestamps in microseconds
+                events.push_back({
+                    {"name", event.name},
+                    {"ph", "X"},
+                    {"pid", 0},
+                    {"tid", buffer->threadId_},
+                    {"ts", event.start / 1000.0},
+                    {"dur", event.duration / 1000.0}
+                });
+            }
+        }
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open file for writing: " + path);
+        }
+        file << json{{"traceEvents", events}, {"displayTimeUnit", "ms"}}.dump();
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+/*
+ * Scoped trace zones exported in the Chrome trace event format, open the file in chrome://tracing or ui.perfetto.dev.
+ *
+ * TRACE_ZONE("name") records the time until the end of the enclosing scope. The name must be a string literal.
+ * Tracing is compiled out when the AB_TRACING CMake option is off.
+ */
+#ifdef AB_TRACING
+    #define TRACE_CONCAT_IMPL(a, b) a##b
+    #define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+    #define TRACE_ZONE(name) trace::Zone TRACE_CONCAT(traceZone_, __LINE__)(name)
+#else
+    #define TRACE_ZONE(name)
+#endif
+
+namespace trace {
+    const size_t TRACE_BUFFER_SIZE = 1 << 15; // Events kept per thread, older events are overwritten
+    const size_t TRACE_EXPORT_MARGIN = 1 << 10; // Oldest events of a full buffer that aren't exported, the owning thread may be overwriting them
+
+    struct Event {
+        const char* name;
+        int64_t start; // Nanoseconds since the tracer started
+        int64_t duration;
+    };
+
+    /**
+     * @brief Events of a single thread
+     *
+     * Only the owning thread writes to the events, the published count lets the exporting thread read them without locks.
+     * Events the owning thread may have overwritten while they were copied are dropped from the export.
+     * Buffers are never freed, so traces of finished threads can still be exported.
+     */
+    class ThreadBuffer {
+        public:
+            ThreadBuffer(int threadId);
+            void add(const char* name, int64_t start, int64_t duration);
+            void setName(const std::string& name);
+        private:
+            std::array<Event, TRACE_BUFFER_SIZE> events_;
+            std::atomic<size_t> count_{0}; // Total number of added events
+            std::string name_;
+            std::mutex nameMutex_; // Guards the name, which can be set while exporting
+            int threadId_;
+            ThreadBuffer* next_ = nullptr; // Next buffer in the lock-free list of all buffers
+            friend void exportChromeTrace(const std::string& path);
+            friend ThreadBuffer& getThreadBuffer();
+    };
+
+    /**
+     * @brief Records the time from construction to destruction in the buffer of the current thread
+     */
+    class Zone {
+        public:
+            Zone(const char* name);
+            ~Zone();
+            Zone(const Zone&) = delete;
+            Zone& operator=(const Zone&) = delete;
+        private:
+            const char* name_;
+            int64_t start_;
+    };
+
+    int64_t now();
+    ThreadBuffer& getThreadBuffer();
+    void setThreadName(const std::string& name);
+    // Writes the events of all threads to a json file, throws std::runtime_error if the file can't be written
+    void exportChromeTrace(const std::string& path);
+}
+
+#endif // TRACE_HPP
@@ -0,0 +1,121 @@
+#include "trajectory.hpp"
+#include "utils.hpp"
+#include <cmath>
+
+const float TRAJECTORY_DOT_SIZE = 3.f; // Half size of a dot in pixels
+const float TRAJECTORY_IMPACT_SIZE = 7.f; // Half size of the impact marker in pixels
+
+namespace {
+    // Finds the closest fixture along a ray
+    class ClosestHitCallback : public b2RayCastCallback {
+        public:
+            bool hasHit = false;
+            b2Vec2 point = b2Vec2_zero;
+            float ReportFixture(b2Fixture* fixture, const b2Vec2& hitPoint, const b2Vec2& normal, float fraction) override {
+                hasHit = true;
+                point = hitPoint;
+                return fraction; // Clip the ray to find the closest hit
+            }
+    };
+
+    void setQuad(sf::VertexArray& vertices, size_t index, const sf::Vector2f& center, float halfSize, const sf::Color& color) {
+        vertices[index].position = center + sf::Vector2f(-halfSize, -halfSize);
+        vertices[index + 1].position = center + sf::Vector2f(halfSize, -halfSize);
+        vertices[index + 2].position = center + sf::Vector2f(halfSize, halfSize);
+        vertices[index + 3].position = center + sf::Vector2f(-halfSize, halfSize);
+        for (size_t i = index; i < index + 4; i++) {
+            vertices[i].color = color;
+        }
+    }
+}
+
+TrajectoryCache::TrajectoryCache() {
+    cache_.reserve(MAX_CACHED_TRAJECTORIES);
+}
+
+int TrajectoryCache::getKey(float direction, float power) {
+    // Direction is between -360 and 360 degrees, so the angle bucket fits in 16 bits
+    int angleBucket = static_cast<int>(std::lround((direction + 360.f) / TRAJECTORY_ANGLE_BUCKET));
+    int powerBucket = static_cast<int>(std::lround(power / TRAJECTORY_POWER_BUCKET));
+    return (powerBucket << 16) | angleBucket;
+}
+
+const TrajectoryPath& TrajectoryCache::update(float direction, float power, const b2Body* birdBody) {
+    int key = getKey(direction, power);
+    auto it = cache_.find(key);
+    if (it == cache_.end()) {
+        if (cache_.size() >= MAX_CACHED_TRAJECTORIES) {
+            cache_.clear();
+        }
+        // Compute the path at the center of the bucket so cached paths don't depend on the order they were created in
+        float bucketDirection = (key & 0xFFFF) * TRAJECTORY_ANGLE_BUCKET - 360.f;
+        float bucketPower = (key >> 16) * TRAJECTORY_POWER_BUCKET;
+        it = cache_.emplace(key, computePath(bucketDirection, bucketPower, birdBody)).first;
+        it->second.key = key;
+    }
+    return it->second;
+}
+
+void TrajectoryCache::clear() {
+    cache_.clear();
+}
+
+// Closed form of Box2D's integration, v(n) = v0 + n * dt * g and x(n) = x0 + sum of v(i) * dt
+TrajectoryPath TrajectoryCache::computePath(float direction, float power, const b2Body* birdBody) {
+    TrajectoryPath path;
+    float radians = utils::DegreesToRadians(direction);
+    // The launch impulse is applied to the center of the bird, so the velocity is impulse / mass
+    b2Vec2 velocity = (power / birdBody->GetMass()) * b2Vec2(std::cos(radians), std::sin(radians));
+    b2Vec2 gravity = birdBody->GetGravityScale() * birdBody->GetWorld()->GetGravity();
+    b2Vec2 start = BIRD_INITIAL_POSITION;
+    path.points[0] = start;
+    path.count = 1;
+    ClosestHitCallback callback;
+    for (int i = 1; i < TRAJECTORY_POINTS; i++) {
+        float t = i * TRAJECTORY_INTERVAL;
+        b2Vec2 point = start + t * velocity + (0.5f * t * (t + TIME_STEP)) * gravity;
+        birdBody->GetWorld()->RayCast(&callback, path.points[i - 1], point);
+        if (callback.hasHit) {
+            path.points[i] = callback.point;
+            path.count = i + 1;
+            path.hasImpact = true;
+            path.impact = callback.point;
+            break;
+        }
+        path.points[i] = point;
+        path.count = i + 1;
+    }
+    return path;
+}
+
+TrajectoryPreview::TrajectoryPreview() : vertices_(sf::Quads) {}
+
+// The vertices are only rebuilt when the path changes
+void TrajectoryPreview::setPath(const TrajectoryPath& path) {
+    if (path.key == currentKey_) {
+        return;
+    }
+    currentKey_ = path.key;
+    // The first point is inside the cannon, so it is skipped
+    size_t dotCount = path.count > 0 ? path.count - 1 : 0;
+    vertices_.resize((dotCount + (path.hasImpact ? 1 : 0)) * 4);
+    for (size_t i = 0; i < dotCount; i++) {
+        // Dots fade out along the path
+        sf::Uint8 alpha = static_cast<sf::Uint8>(230 - 150 * i / TRAJECTORY_POINTS);
+        setQuad(vertices_, i * 4, utils::B2ToSfCoords(path.points[i + 1]), TRAJECTORY_DOT_SIZE, sf::Color(255, 255, 255, alpha));
+    }
+    if (path.hasImpact) {
+        setQuad(vertices_, dotCount * 4, utils::B2ToSfCoords(path.impact), TRAJECTORY_IMPACT_SIZE, sf::Color(255, 60, 60, 220));
+    }
+}
+
+void TrajectoryPreview::clear() {
+    vertices_.clear();
+    currentKey_ = -1;
+}
+
+void TrajectoryPreview::draw(RenderQueue& window) const {
+    if (vertices_.getVertexCount() > 0) {
+        window.draw(vertices_);
+    }
+}
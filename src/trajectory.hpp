@@ -0,0 +1,67 @@
+#ifndef TRAJECTORY_HPP
+#define TRAJECTORY_HPP
+
+#include <box2d/box2d.h>
+#include <SFML/Graphics.hpp>
+#include "render_queue.hpp"
+#include <array>
+#include <unordered_map>
+
+const int TRAJECTORY_POINTS = 30; // Number of dots in the preview
+const float TRAJECTORY_INTERVAL = 0.05f; // Seconds of flight between two dots
+const float TRAJECTORY_ANGLE_BUCKET = 0.5f; // Degrees
+const float TRAJECTORY_POWER_BUCKET = 0.02f; // Impulse, power goes from 0 to 4
+const size_t MAX_CACHED_TRAJECTORIES = 512;
+
+/**
+ * @brief Predicted flight of a bird in Box2D coordinates
+ *
+ * @param key The angle and power bucket of the path, -1 for no path
+ * @param points The predicted positions of the bird, one every TRAJECTORY_INTERVAL seconds
+ * @param count Number of valid points, smaller than TRAJECTORY_POINTS if the path hits something
+ * @param hasImpact Whether the path hits a fixture within the lookahead
+ * @param impact The first point where the path hits a fixture
+ */
+struct TrajectoryPath {
+    int key = -1;
+    std::array<b2Vec2, TRAJECTORY_POINTS> points;
+    int count = 0;
+    bool hasImpact = false;
+    b2Vec2 impact = b2Vec2_zero;
+};
+
+/**
+ * @brief Computes and caches predicted bird paths, used by the thread that steps the world
+ *
+ * Points are computed in closed form from the launch impulse, bird mass and gravity, matching the
+ * semi-implicit Euler integration of Box2D. The path is ray cast against the broadphase to find the first impact.
+ * Paths are cached per angle and power bucket. The cache must be cleared whenever the world changes, e.g. when a bird is launched.
+ */
+class TrajectoryCache {
+    public:
+        TrajectoryCache();
+        const TrajectoryPath& update(float direction, float power, const b2Body* birdBody);
+        void clear();
+    private:
+        std::unordered_map<int, TrajectoryPath> cache_;
+        static int getKey(float direction, float power);
+        static TrajectoryPath computePath(float direction, float power, const b2Body* birdBody);
+};
+
+/**
+ * @brief Trajectory preview drawn while the player charges the cannon
+ *
+ * The path is drawn as a single vertex array that is only rebuilt when the path changes.
+ */
+class TrajectoryPreview {
+    public:
+        TrajectoryPreview();
+        void setPath(const TrajectoryPath& path);
+        void clear();
+        void draw(RenderQueue& window) const;
+    private:
+        sf::VertexArray vertices_;
+        int currentKey_ = -1;
+};
+
+#endif // TRAJECTORY_HPP
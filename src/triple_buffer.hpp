@@ -0,0 +1,46 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+
+/**
+ * @brief Lock-free triple buffer for passing the latest value from one producer thread to one consumer thread
+ *
+ * The producer writes to the back buffer and publishes it, the consumer picks up the latest published buffer.
+ * Neither side ever waits, the producer may overwrite values the consumer never saw.
+ * Buffers are reused, so values with containers keep their capacity between publishes.
+ */
+template <typename T>
+class TripleBuffer {
+    public:
+        // Producer side
+        T& back() {
+            return buffers_[back_];
+        }
+        void publish() {
+            int previous = shared_.exchange(back_ | NEW_DATA, std::memory_order_acq_rel);
+            back_ = previous & INDEX_MASK;
+        }
+        // Consumer side, returns whether a new value was picked up
+        bool update() {
+            if ((shared_.load(std::memory_order_relaxed) & NEW_DATA) == 0) {
+                return false;
+            }
+            int previous = shared_.exchange(front_, std::memory_order_acq_rel);
+            front_ = previous & INDEX_MASK;
+            return true;
+        }
+        const T& front() const {
+            return buffers_[front_];
+        }
+    private:
+        static constexpr int INDEX_MASK = 3;
+        static constexpr int NEW_DATA = 4;
+        std::array<T, 3> buffers_;
+        int back_ = 0; // Only used by the producer
+        int front_ = 1; // Only used by the consumer
+        std::atomic<int> shared_{2}; // Index of the middle buffer and whether it holds unread data
+};
+
+#endif // TRIPLE_BUFFER_HPP
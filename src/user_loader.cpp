@@ -1,4 +1,5 @@
 #include "user_loader.hpp"
+#include "trace.hpp"
 #include "user_selector.hpp"
 
 
@@ -63,6 +64,7 @@ void UserLoader::loadPlayer(int index) {
 }
 
 void UserLoader::savePlayer() {
+    TRACE_ZONE("UserLoader::savePlayer");
     if (!userSelector_.player_) {
         throw std::runtime_error("No player loaded to save.");
     }
@@ -113,7 +113,7 @@ void UserSelector::initializePlayerNames() {
     }
 }
 
-void UserSelector::drawNewPlayer(sf::RenderWindow& window) const {
+void UserSelector::drawNewPlayer(RenderQueue& window) const {
     if (isPlayerSet() && !isPlayerAccepted_) {
         window.draw(acceptText_[0]);
         window.draw(acceptText_[1]);
@@ -125,7 +125,7 @@ void UserSelector::drawNewPlayer(sf::RenderWindow& window) const {
     }
 }
 
-void UserSelector::drawLoadPlayer(sf::RenderWindow& window) const {
+void UserSelector::drawLoadPlayer(RenderQueue& window) const {
     for (int i = range_.start; i < range_.end; i++) {
         window.draw(playerNames_[i]);
     }
@@ -140,7 +140,7 @@ void UserSelector::drawLoadPlayer(sf::RenderWindow& window) const {
     window.draw(acceptText_[2]);
 }
 
-void UserSelector::draw(sf::RenderWindow& window) const {
+void UserSelector::draw(RenderQueue& window) const {
     window.draw(promptText_);
     if (screen_ == UserSelector::Screen::NEW_PLAYER) {
         drawNewPlayer(window);
@@ -2,6 +2,7 @@
 #define USER_SELECTOR_HPP
 
 #include <SFML/Graphics.hpp>
+#include "render_queue.hpp"
 #include "user_loader.hpp"
 
 class UserSelector {
@@ -24,7 +25,7 @@ class UserSelector {
             int end = 0;
         };
         UserSelector();
-        void draw(sf::RenderWindow& window) const;
+        void draw(RenderQueue& window) const;
         void handleMouseMove(const sf::Vector2f& mousePosition);
         bool handleMouseClick(const sf::Vector2f& mousePosition);
         void handleKeyPress(const sf::Keyboard::Key& code);
@@ -71,8 +72,8 @@ class UserSelector {
         friend class UserLoader;
         UserLoader userLoader_;
         std::shared_ptr<Player> player_ = nullptr; // Solo owner of the player, other classes only have weak_ptr
-        void drawNewPlayer(sf::RenderWindow& window) const;
-        void drawLoadPlayer(sf::RenderWindow& window) const;
+        void drawNewPlayer(RenderQueue& window) const;
+        void drawLoadPlayer(RenderQueue& window) const;
         void initializePlayerNames();
         const int getSelectedPlayerIndex() const;
 };
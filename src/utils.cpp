@@ -1,4 +1,5 @@
 #include "utils.hpp"
+#include <algorithm>
 
 std::istream &operator>>(std::istream &input, b2Vec2 &vector) {
     float x,y;
@@ -145,6 +146,19 @@ namespace utils
         return corners;
     }
 
+    // Function to get the corners of a rotated box in the same order as getSpriteCorners, rotation is in degrees
+    std::array<sf::Vector2f, 4> getBoxCorners(const sf::Vector2f& center, const sf::Vector2f& halfSize, float rotation) {
+        sf::Transform transform;
+        transform.translate(center).rotate(rotation);
+        std::array<sf::Vector2f, 4> corners = {
+            transform.transformPoint(-halfSize.x, -halfSize.y),
+            transform.transformPoint(halfSize.x, -halfSize.y),
+            transform.transformPoint(-halfSize.x, halfSize.y),
+            transform.transformPoint(halfSize.x, halfSize.y)
+        };
+        return corners;
+    }
+
 
     // Helper function to project a point onto an axis
     float projectOntoAxis(const sf::Vector2f& point, const sf::Vector2f& axis) {
@@ -170,9 +184,11 @@ namespace utils
     // SAT collision detection between two sprites
     bool checkOBBCollision(const sf::Sprite& spriteA, const sf::Sprite& spriteB) {
         // Get the corners of both sprites
-        auto cornersA = getSpriteCorners(spriteA);
-        auto cornersB = getSpriteCorners(spriteB);
+        return checkOBBCollision(getSpriteCorners(spriteA), getSpriteCorners(spriteB));
+    }
 
+    // SAT collision detection between two boxes given by their corners
+    bool checkOBBCollision(const std::array<sf::Vector2f, 4>& cornersA, const std::array<sf::Vector2f, 4>& cornersB) {
         // Define potential separating axes (normals of the edges)
         std::array<sf::Vector2f, 4> axes = {
             sf::Vector2f(cornersA[1].x - cornersA[0].x, cornersA[1].y - cornersA[0].y),  // Edge 1 of sprite A
@@ -201,6 +217,30 @@ namespace utils
         return true;
     }
 
+    bool isBodyMoving(const b2Body* body) {
+        return (
+            body->GetLinearVelocity().LengthSquared() > IS_SETTLED_THRESHOLD
+            || fabs(body->GetAngularVelocity()) > IS_SETTLED_THRESHOLD
+        );
+    }
+
+    static float worldWidth = WORLD_WIDTH;
+
+    // Box2D position is out of bounds when it is left or right of the world or below the screen
+    bool isOutOfBounds(const b2Vec2& position) {
+        sf::Vector2f sfPosition = B2ToSfCoords(position);
+        return sfPosition.x < 0 || sfPosition.y > VIEW.getHeight() || sfPosition.x > worldWidth;
+    }
+
+    // Set by the main thread when a level is loaded, while the physics thread is paused
+    float getWorldWidth() {
+        return worldWidth;
+    }
+
+    void setWorldWidth(float width) {
+        worldWidth = width;
+    }
+
     int countFilesInDirectory() {
         // Get the path of the folder containing the levels
         std::string folderPath = utils::getExecutablePath() + "/assets/levels/";
@@ -215,4 +255,19 @@ namespace utils
 
         return fileCount;
     }
+
+    void collectLevelFiles(const fs::path& path, std::vector<fs::path>& files) {
+        if (fs::is_directory(path)) {
+            std::vector<fs::path> levels;
+            for (const auto& entry : fs::directory_iterator(path)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".json") {
+                    levels.push_back(entry.path());
+                }
+            }
+            std::sort(levels.begin(), levels.end());
+            files.insert(files.end(), levels.begin(), levels.end());
+        } else {
+            files.push_back(path);
+        }
+    }
 }
\ No newline at end of file
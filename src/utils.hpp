@@ -21,6 +21,7 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 #include <filesystem>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -100,13 +101,29 @@ namespace utils
 
     std::array<sf::Vector2f, 4> getSpriteCorners(const sf::Sprite& sprite);
 
+    std::array<sf::Vector2f, 4> getBoxCorners(const sf::Vector2f& center, const sf::Vector2f& halfSize, float rotation);
+
     float projectOntoAxis(const sf::Vector2f& point, const sf::Vector2f& axis);
 
     std::pair<float, float> getMinMaxProjection(const std::array<sf::Vector2f, 4>& corners, const sf::Vector2f& axis);
 
     bool checkOBBCollision(const sf::Sprite& spriteA, const sf::Sprite& spriteB);
 
+    bool checkOBBCollision(const std::array<sf::Vector2f, 4>& cornersA, const std::array<sf::Vector2f, 4>& cornersB);
+
+    bool isBodyMoving(const b2Body* body);
+
+    bool isOutOfBounds(const b2Vec2& position);
+
+    // Width of the loaded level in pixels, WORLD_WIDTH unless the level is split into chunks
+    float getWorldWidth();
+
+    void setWorldWidth(float width);
+
     int countFilesInDirectory();
+
+    // Appends the level file at path, or the json files of the directory at path in name order, used by the command line tools
+    void collectLevelFiles(const fs::path& path, std::vector<fs::path>& files);
 }
 
 #endif // UTILS_HPP
\ No newline at end of file
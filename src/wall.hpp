@@ -3,12 +3,17 @@
 
 #include "object.hpp"
 
+const std::string WALL_TEXTURE = "/assets/images/box.png";
+const float WALL_HEALTH = 500.f;
+
 class Wall : public Object {
     public:
-        Wall(b2Body *body, float hx, float hy);
+        Wall(b2Body *body, float hx, float hy, const sf::Texture& texture);
         virtual char getTypeAsChar() const override;
         bool shouldRemove() const override;
-        virtual void handleCollision(Object* objectB) override;
+        const b2Vec2& getHalfSize() const;
+    private:
+        b2Vec2 halfSize_;
 };
 
 #endif // WALL_HPP
\ No newline at end of file
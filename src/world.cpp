@@ -1,29 +1,32 @@
 #include "world.hpp"
 #include "utils.hpp"
+#include "frame_profiler.hpp"
+#include "trace.hpp"
+#include "damage_table.hpp"
+#include "audio_service.hpp"
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
-
-World::World() : gravity_(0.0f, -9.8f), levelLoader_(*this), scoreManager_() {
+World::World() : gravity_(0.0f, -9.8f), levelLoader_(*this), scoreManager_(), fragments_(events_) {
     world_ = new b2World(gravity_);
+    world_->SetContactListener(&impactListener_);
     cannon_ = new Cannon();
-    int height = VIEW.getHeight();
-    sf::Texture& backgroundImage = ResourceManager::getInstance().getTexture("/assets/images/background2.jpg");
-    auto size = backgroundImage.getSize();
-    auto scaleFactor = utils::getScaleFactor(size.x, size.y, VIEW.getWidth() * 2.f, height * 1.8f);
-    background_.setSize(sf::Vector2f(size.x * scaleFactor, size.y * scaleFactor));
-    background_.setTexture(&backgroundImage);
-    background_.setPosition(0,-height+ 200);
 }
 
 World::~World() {
     for (auto object : objects_) {
         delete object;
     }
+    for (auto object : removedObjects_) {
+        delete object;
+    }
     for (auto bird : birds_) {
         delete bird;
     }
+    for (auto bird : removedBirds_) {
+        delete bird;
+    }
     delete cannon_;
     delete world_;
 }
@@ -31,14 +34,34 @@ World::~World() {
 void World::addObject(Object *object) {
     if (object->getType() == Object::Type::Bird) {
         birds_.push_back(dynamic_cast<Bird *>(object));
+        birdNodes_.push_back(std::prev(birds_.end()));
     } else {
         objects_.push_back(object);
+        objectNodes_.push_back(std::prev(objects_.end()));
     }
 }
 
 
 void World::loadLevel(const std::string& filename) {
     levelLoader_.loadLevel(filename);
+    lod_.track(objects_);
+    fragments_.create(*world_);
+    for (auto object : objects_) {
+        if (object->getType() == Object::Type::Wall) {
+            fragments_.cacheLayout(*static_cast<Wall*>(object));
+        }
+    }
+    // The chunks in view at the start are part of the level start, the rest are streamed in while the level runs
+    cameraX_ = VIEW.getCenter().x / SCALE;
+    if (chunks_.hasChunks()) {
+        chunks_.update(cameraX_, cameraX_);
+        chunks_.waitForLoads();
+        updateChunks();
+    }
+    saveState(levelStartState_);
+    // Size the shot state once, so saving it before each shot doesn't allocate
+    shotState_ = levelStartState_;
+    shotState_.isSaved = false;
 }
 
 void World::saveHighScore(int score) {
@@ -75,8 +98,9 @@ int World::getStars() const {
 
 }
 
+// Pigs of chunks that haven't been created yet are counted from the chunk index
 int World::getRemainingPigCount() const {
-    int count = 0;
+    int count = chunks_.getPendingPigCount();
     for (auto object : objects_) {
         if (object->getType() == Object::Type::Pig) {
             count++;
@@ -98,6 +122,224 @@ int World::getRemainingBirdCount() const {
 
 void World::step() {
     world_->Step(TIME_STEP, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+    physicsStats_ = FrameProfiler::capturePhysicsStats(*world_, FrameProfiler::getInstance().isEnabled());
+    physicsStats_.frozenBodyCount = lod_.getFrozenCount();
+}
+
+// The flying bird is the focus of the level of detail, bodies about to be hit by a blast are woken before it goes off
+void World::updateLod() {
+    const Bird* bird = GetBird();
+    if (bird != nullptr && bird->isLaunched()) {
+        b2Vec2 focus = bird->getBody()->GetPosition();
+        lod_.update(&focus, TIME_STEP);
+    } else {
+        lod_.update(nullptr, TIME_STEP);
+    }
+    for (size_t i = 0; i < blasts_.getPendingCount(); i++) {
+        const Blast& blast = blasts_.getPendingBlast(i);
+        lod_.wake(blast.center, blast.radius);
+    }
+}
+
+// Creates the chunks coming into range of the camera or the flying bird and disables the ones left behind
+void World::updateChunks() {
+    if (!chunks_.hasChunks()) {
+        return;
+    }
+    const Bird* bird = GetBird();
+    float birdX = bird != nullptr && bird->isLaunched() ? bird->getBody()->GetPosition().x : cameraX_;
+    chunks_.update(cameraX_, birdX);
+    for (size_t i = 0; i < chunks_.getCount(); i++) {
+        if (chunks_.isInRange(i, CHUNK_ACTIVE_RANGE)) {
+            if (!chunks_.isCreated(i) && chunks_.takeObjects(i, chunkObjects_)) {
+                createChunkObjects(i);
+            }
+            chunks_.setActive(i, true);
+        } else if (!chunks_.isInRange(i, CHUNK_ACTIVE_RANGE + 1)) {
+            // One chunk of slack, so a camera moving back and forth at a chunk edge doesn't toggle the bodies
+            chunks_.setActive(i, false);
+        }
+    }
+}
+
+void World::createChunkObjects(size_t i) {
+    TRACE_ZONE("World::createChunkObjects");
+    std::vector<Object*>& objects = chunks_.getObjects(i);
+    size_t firstNode = objectNodes_.size();
+    for (const auto& chunkObject : chunkObjects_) {
+        Object* object = levelLoader_.loadObject(chunkObject.data, chunkObject.shapeData);
+        objects.push_back(object);
+        lod_.add(object);
+        if (object->getType() == Object::Type::Wall) {
+            fragments_.cacheLayout(*static_cast<Wall*>(object));
+        }
+    }
+    chunkObjects_.clear();
+    // The objects didn't exist when the saved states were taken, restoring those puts them back to where they were created
+    for (WorldState* state : {&levelStartState_, &shotState_}) {
+        if (!state->isSaved) {
+            continue;
+        }
+        state->objects.resize(objectNodes_.size());
+        for (size_t node = firstNode; node < objectNodes_.size(); node++) {
+            (*objectNodes_[node])->saveState(state->objects[node]);
+        }
+    }
+}
+
+// One fixed step of the simulation, run on the physics thread
+void World::tick() {
+    {
+        ScopedTimer timer(phaseTimes_[0]);
+        TRACE_ZONE("World::step");
+        updateChunks();
+        updateLod();
+        step();
+        impactListener_.flush();
+    }
+    // Check if level is ended, the main thread handles the level end
+    isSettled_ = isSettled();
+    {
+        ScopedTimer timer(phaseTimes_[1]);
+        TRACE_ZONE("World::handleCollisions");
+        handleCollisions();
+        blasts_.step(*world_);
+    }
+    {
+        ScopedTimer timer(phaseTimes_[2]);
+        TRACE_ZONE("World::handleObjectState");
+        handleObjectState();
+        fragments_.update(TIME_STEP);
+    }
+    {
+        ScopedTimer timer(phaseTimes_[3]);
+        TRACE_ZONE("World::handleBirdState");
+        handleBirdState();
+    }
+}
+
+void World::applyCommand(const WorldCommand& command) {
+    switch (command.type) {
+        case WorldCommand::Type::Aim: {
+            const Bird* bird = GetBird();
+            if (bird != nullptr && !bird->isLaunched()) {
+                trajectory_ = trajectoryCache_.update(command.direction, command.power, bird->getBody());
+            }
+            break;
+        }
+        case WorldCommand::Type::Launch:
+            launchBird(command.direction, command.power);
+            break;
+        case WorldCommand::Type::UsePower:
+            useBirdPower();
+            break;
+        case WorldCommand::Type::KeyPress:
+            handleKeyPress(command.key);
+            break;
+        case WorldCommand::Type::Camera:
+            cameraX_ = command.cameraX;
+            break;
+    }
+}
+
+void World::captureSnapshot(WorldSnapshot& snapshot) const {
+    snapshot.sprites.clear();
+    snapshot.staticSprites.clear();
+    // FNV-1a hash of the render keys of the static objects, it changes when one of them changes, wakes up or is removed
+    uint64_t staticKey = 14695981039346656037ull;
+    for (auto object : objects_) {
+        // Objects of chunks out of range are disabled and not drawn
+        const b2Body* body = object->getBody();
+        if (!body->IsEnabled()) {
+            continue;
+        }
+        // Static and frozen bodies are never awake
+        if (body->IsAwake()) {
+            object->captureSprites(snapshot.sprites);
+        } else {
+            object->captureSprites(snapshot.staticSprites);
+            staticKey = (staticKey ^ object->getRenderKey()) * 1099511628211ull;
+        }
+    }
+    snapshot.staticKey = staticKey;
+    fragments_.captureSprites(snapshot.sprites);
+    const Bird* bird = GetBird();
+    snapshot.hasBird = bird != nullptr;
+    snapshot.isBirdLaunched = bird != nullptr && bird->isLaunched();
+    snapshot.isBirdMoving = bird != nullptr && bird->isMoving();
+    if (bird != nullptr) {
+        snapshot.birdPosition = utils::B2ToSfCoords(bird->getBody()->GetPosition());
+        bird->captureSprites(snapshot.sprites);
+    }
+    snapshot.isSettled = isSettled_;
+    snapshot.trajectory = trajectory_;
+    snapshot.phaseTimes = phaseTimes_;
+    snapshot.physicsStats = physicsStats_;
+}
+
+// Apply the objects removed by the physics thread to the score, the remaining counts and the destruction effects
+void World::handleEvents() {
+    chunks_.rethrowError();
+    WorldEvent event;
+    while (events_.pop(event)) {
+        updateRemainingCounts(event.type);
+        if (event.score != 0) {
+            updateScore(event.score);
+        }
+        if (!utils::isOutOfBounds(utils::SfToB2Coords(event.position))) {
+            particles_.emitDestruction(event.type, event.position, event.size);
+        }
+    }
+}
+
+// Moves the destruction effects by one frame and plays the impacts of the physics thread, called by the main thread while the level runs
+void World::updateEffects() {
+    particles_.update(TIME_STEP);
+    AudioService& audio = AudioService::getInstance();
+    audio.beginFrame(listenerPosition_);
+    ImpactEvent impact;
+    while (impacts_.pop(impact)) {
+        audio.playImpact(impact);
+    }
+}
+
+void World::setListenerPosition(const sf::Vector2f& position) {
+    listenerPosition_ = position;
+}
+
+// Drops the impacts of the previous state and stops their sounds
+void World::clearImpacts() {
+    impactListener_.clear();
+    ImpactEvent impact;
+    while (impacts_.pop(impact)) {}
+    AudioService::getInstance().stopAll();
+}
+
+// Removal of an object for the main thread, called by the physics thread
+void World::pushRemovedEvent(const Object& object, int score) {
+    WorldEvent event;
+    event.type = object.getTypeAsChar();
+    event.score = score;
+    event.position = object.getSprite().getPosition();
+    sf::FloatRect bounds = object.getSprite().getGlobalBounds();
+    event.size = std::max(bounds.width, bounds.height);
+    events_.push(event);
+}
+
+void World::launchBird(float direction, float power) {
+    Bird* bird = GetBird();
+    if (bird == nullptr || bird->isLaunched()) {
+        return;
+    }
+    // Activate bird's body in b2World
+    bird->getBody()->SetEnabled(true);
+    float x = cos(utils::DegreesToRadians(direction)) * power;
+    float y = sin(utils::DegreesToRadians(direction)) * power;
+    bird->getBody()->ApplyLinearImpulseToCenter(b2Vec2(x, y), true);
+    bird->setLaunched(true);
+    // The world changes after the launch, so the cached paths are no longer valid
+    trajectoryCache_.clear();
+    trajectory_ = TrajectoryPath();
 }
 
 b2World* World::getWorld() {
@@ -118,37 +360,40 @@ const Bird* World::GetBird() const {
     return birds_.front();
 }
 
-void World::draw(sf::RenderWindow &window) const {
-    window.draw(background_);
+// Objects are drawn from the snapshot since the physics thread owns them
+// The sleeping objects are cached by the render thread, the parallax background scrolls with the camera and is drawn every frame
+void World::draw(RenderQueue& window, const WorldSnapshot& snapshot) const {
+    background_.draw(window);
+    window.beginLayer(snapshot.staticKey);
+    background_.drawBase(window);
+    for (const auto& sprite : snapshot.staticSprites) {
+        window.draw(sprite);
+    }
+    window.endLayer();
     scoreManager_.draw(window);
     drawRemainingCounts(window);
-    for (auto object : objects_) {
-        object->draw(window);
-    }
-    const Bird* bird = GetBird();
-    if (bird != nullptr && bird->isLaunched()) {
-        bird->draw(window);
+    for (const auto& sprite : snapshot.sprites) {
+        window.draw(sprite);
     }
+    particles_.draw(window);
     cannon_->draw(window);
 }
 
 std::list<Object*>::iterator World::removeObject(std::list<Object*>::iterator it) {
-    Object* object = *it;
-    // Remove object from the Box2D world
-    world_->DestroyBody(object->getBody());
-    // Erase the object from the list and return the next valid iterator & free memory
-    it = objects_.erase(it);
-    delete object;
-    // Return the next valid iterator
-    return it;
+    // Take the object out of the Box2D world, it is kept for restoring a saved state
+    lod_.wakeTouching((*it)->getBody());
+    (*it)->disable();
+    // Move the node to the removed objects and return the next valid iterator
+    auto next = std::next(it);
+    removedObjects_.splice(removedObjects_.end(), objects_, it);
+    return next;
 }
 
 void World::removeBird() {
     if (!birds_.empty()) {
-        Bird* bird = birds_.front();
-        world_->DestroyBody(bird->getBody());
-        birds_.pop_front();
-        delete bird;
+        lod_.wakeTouching(birds_.front()->getBody());
+        birds_.front()->disable();
+        removedBirds_.splice(removedBirds_.end(), birds_, birds_.begin());
     }
 }
 
@@ -181,27 +426,136 @@ void World::clearLevel() {
         delete object;
     }
     objects_.clear();
+    for (auto object : removedObjects_) {
+        delete object;
+    }
+    removedObjects_.clear();
+    objectNodes_.clear();
 
     // Clear the birds
     for (auto bird : birds_) {
         delete bird;
     }
     birds_.clear();
+    for (auto bird : removedBirds_) {
+        delete bird;
+    }
+    removedBirds_.clear();
+    birdNodes_.clear();
+    levelStartState_.isSaved = false;
+    shotState_.isSaved = false;
 
-    // Reset cannon
+    // Reset cannon and the state of the previous level
     cannon_->reset();
+    trajectoryCache_.clear();
+    trajectory_ = TrajectoryPath();
+    isSettled_ = false;
+    blasts_.clear();
+    lod_.clear();
+    chunks_.clear();
+    chunkObjects_.clear();
+    utils::setWorldWidth(WORLD_WIDTH);
+    fragments_.release();
+    particles_.clear();
+    clearImpacts();
+    WorldEvent event;
+    while (events_.pop(event)) {}
 
     // reset score
     scoreManager_.reset();
 };
 
+// Restarts the level from the state saved when it was loaded, the level file is only reloaded if there is no saved state
 void World::resetLevel() {
-    // Clear the level
+    if (levelStartState_.isSaved) {
+        restoreState(levelStartState_);
+        return;
+    }
     clearLevel();
-    // Reload the level
     loadLevel(fileName_);
 }
 
+// Saves the state of the level into flat arrays, the arrays are reused so saving into the same state again doesn't allocate
+void World::saveState(WorldState& state) const {
+    state.objects.resize(objectNodes_.size());
+    for (size_t i = 0; i < objectNodes_.size(); i++) {
+        (*objectNodes_[i])->saveState(state.objects[i]);
+    }
+    state.birds.resize(birdNodes_.size());
+    for (size_t i = 0; i < birdNodes_.size(); i++) {
+        (*birdNodes_[i])->saveState(state.birds[i]);
+    }
+    state.remainingCounts.resize(sfObjects_.size());
+    size_t index = 0;
+    for (const auto& sfObject : sfObjects_) {
+        state.remainingCounts[index++] = sfObject.count;
+    }
+    state.score = scoreManager_.getCurrentScore();
+    state.isSaved = true;
+}
+
+// Restores a state saved from the current level in place, bodies are moved back instead of being recreated
+void World::restoreState(const WorldState& state) {
+    // Thaw the frozen bodies, the restored state decides which bodies are awake
+    lod_.reset();
+    restoreObjects(objects_, removedObjects_, objectNodes_, state.objects);
+    restoreObjects(birds_, removedBirds_, birdNodes_, state.birds);
+    size_t index = 0;
+    for (auto& sfObject : sfObjects_) {
+        if (index < state.remainingCounts.size()) {
+            sfObject.count = state.remainingCounts[index++];
+            sfObject.text.format("%d", sfObject.count);
+        }
+    }
+    scoreManager_.reset();
+    scoreManager_.update(state.score);
+    cannon_->reset();
+    trajectoryCache_.clear();
+    trajectory_ = TrajectoryPath();
+    isSettled_ = false;
+    blasts_.clear();
+    fragments_.clear();
+    particles_.clear();
+    clearImpacts();
+    WorldEvent event;
+    while (events_.pop(event)) {}
+    // A shot made before the restored state can't be undone anymore
+    shotState_.isSaved = false;
+    // The restored bodies of chunks are enabled again only in range of the camera
+    chunks_.deactivateAll();
+    updateChunks();
+}
+
+// Saves the state before the current bird is launched, called by the main thread while the physics thread is paused
+void World::saveShotState() {
+    handleEvents();
+    saveState(shotState_);
+}
+
+// Returns to the state before the last shot, returns whether there was a shot to undo
+bool World::undoShot() {
+    if (!shotState_.isSaved) {
+        return false;
+    }
+    restoreState(shotState_);
+    return true;
+}
+
+// Moves every node back to the active or removed list in load order and restores the objects
+template <typename T>
+void World::restoreObjects(std::list<T*>& active, std::list<T*>& removed, const std::vector<typename std::list<T*>::iterator>& nodes, const std::vector<ObjectState>& states) {
+    active.splice(active.end(), removed);
+    for (size_t i = 0; i < nodes.size() && i < states.size(); i++) {
+        auto node = nodes[i];
+        (*node)->restoreState(states[i]);
+        if (states[i].isRemoved) {
+            removed.splice(removed.end(), active, node);
+        } else {
+            active.splice(active.end(), active, node);
+        }
+    }
+}
+
 void World::updateScore(int score) {
     scoreManager_.update(score);
 }
@@ -210,10 +564,10 @@ Score& World::getScore() {
     return scoreManager_;
 }
 
-void World::drawRemainingCounts(sf::RenderWindow &window) const {
+void World::drawRemainingCounts(RenderQueue& window) const {
     for (const auto& sfObject : sfObjects_) {
         window.draw(sfObject.sprite);
-        window.draw(sfObject.text);
+        sfObject.text.draw(window);
     }
 }
 
@@ -230,7 +584,7 @@ void World::updateRemainingCounts(char type) {
     for (auto& sfObject : sfObjects_) {
         if (sfObject.type == type) {
             sfObject.count--;
-            sfObject.text.setString(std::to_string(sfObject.count));
+            sfObject.text.format("%d", sfObject.count);
             break;
         }
     }
@@ -298,6 +652,14 @@ bool World::isSettled() const {
         return false;  // Bird is still moving
     }
 
+    if (blasts_.hasPendingBlasts()) {
+        return false;  // A blast or chain reaction is about to go off
+    }
+
+    if (!fragments_.isSettled()) {
+        return false;  // Fragments of destroyed walls are still flying
+    }
+
     // Check if any objects are still moving
     for (auto object : objects_) {
         if (object->isMoving()) {
@@ -309,25 +671,13 @@ bool World::isSettled() const {
 }
 
 void World::handleResize() {
-    // Original dimensions of the background image
-    float originalWidth = WORLD_WIDTH;
-    float originalHeight = WORLD_HEIGHT;
-
-    // Calculate the scale factors based on the new window size
-    float scaleX = (2 * VIEW.getWidth()) / originalWidth;
-    float scaleY = (1.8f * VIEW.getHeight()) / originalHeight;
-
-    // Choose the smaller of the two scale factors
-    float scaleFactor = std::min(scaleX, scaleY);
-
-    // Apply the scaling to the background (this scales both axes proportionally)
-    background_.setScale(scaleFactor, scaleFactor);
-    background_.setPosition(0, -VIEW.getHeight() + 200);
+    background_.handleResize();
     // Resize cannon properties
     cannon_->handleResize();
     
     // Update object positions
     for (auto& object : objects_) {
+        object->markDirty();
         object->update();
     }
 }
@@ -364,8 +714,9 @@ void World::updateHUD(const sf::RenderWindow& window) {
     updateRemainingCountPositions(window);
 }
 
+// Contact damage of both objects of each contact is resolved from the DamageTable
 void World::handleCollisions() {
-    // Check for collisions
+    const DamageTable& damageTable = DamageTable::getInstance();
     for (b2Contact *ce = world_->GetContactList(); ce; ce = ce->GetNext()) {
         b2Contact *c = ce;
 
@@ -375,8 +726,8 @@ void World::handleCollisions() {
         if (objectA == nullptr || objectB == nullptr) {
             continue;
         }
-        objectA->handleCollision(objectB);
-        objectB->handleCollision(objectA);
+        damageTable.applyContact(*objectA, *objectB);
+        damageTable.applyContact(*objectB, *objectA);
     }
 }
 
@@ -386,10 +737,11 @@ void World::handleObjectState() {
    for (std::list<Object*>::iterator it = objects_.begin(); it != objects_.end(); ) {
         Object* object = *it;
         if (object->shouldRemove()) {
-            if (object->getType() == Object::Type::Pig) {
-                updateRemainingCounts(object->getTypeAsChar());
+            // Destroyed walls break into fragments, walls out of bounds just disappear
+            if (object->getType() == Object::Type::Wall && object->isDestroyed()) {
+                fragments_.fracture(*static_cast<Wall*>(object));
             }
-            updateScore(object->getDestructionScore());
+            pushRemovedEvent(*object, object->getDestructionScore());
             it = removeObject(it); // Remove object and get next valid iterator
         } else {
             object->update();
@@ -403,7 +755,12 @@ void World::handleBirdState() {
     Bird *bird = GetBird();
     if (bird != nullptr) {
         if (bird->shouldRemove()) {
-            updateRemainingCounts(bird->getTypeAsChar());
+            pushRemovedEvent(*bird, 0);
+            // A destroyed bird of an exploding type goes off where it was destroyed
+            const BlastType* blast = blasts_.getType(bird->getTypeAsChar());
+            if (blast != nullptr && bird->isDestroyed()) {
+                blasts_.addBlast(bird->getBody()->GetPosition(), *blast);
+            }
             removeBird();
         } else {
             bird->update();
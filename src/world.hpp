@@ -12,14 +12,40 @@
 #include "resource_manager.hpp"
 #include "score.hpp"
 #include "user_loader.hpp"
+#include "world_snapshot.hpp"
+#include "spsc_queue.hpp"
+#include "blast.hpp"
+#include "particle_system.hpp"
+#include "fragment_pool.hpp"
+#include "body_lod.hpp"
+#include "chunk_streamer.hpp"
+#include "impact_listener.hpp"
+#include "parallax_background.hpp"
 
 struct SfObject {
     sf::Sprite sprite;
-    sf::Text text;
+    HudText text;
     char type;
     int count;
 };
 
+/**
+ * @brief Saved state of a loaded level, restored in place by World::restoreState
+ *
+ * @param objects State of each level object in load order
+ * @param birds State of each bird in load order
+ * @param remainingCounts Remaining count shown next to each bird and pig type in the HUD
+ * @param score Current score
+ * @param isSaved Whether the state holds a saved level
+ */
+struct WorldState {
+    std::vector<ObjectState> objects;
+    std::vector<ObjectState> birds;
+    std::vector<int> remainingCounts;
+    int score = 0;
+    bool isSaved = false;
+};
+
 class World {
     public:
         World();
@@ -27,10 +53,20 @@ class World {
         void loadLevel(const std::string& filename);
         void clearLevel();
         void resetLevel();
+        void saveState(WorldState& state) const;
+        void restoreState(const WorldState& state);
+        void saveShotState();
+        bool undoShot();
         void saveHighScore(int score);
         void addObject(Object *object);
         void step();
-        void draw(sf::RenderWindow &window) const;
+        void tick();
+        void applyCommand(const WorldCommand& command);
+        void captureSnapshot(WorldSnapshot& snapshot) const;
+        void handleEvents();
+        void updateEffects();
+        void setListenerPosition(const sf::Vector2f& position);
+        void draw(RenderQueue& window, const WorldSnapshot& snapshot) const;
         Bird *GetBird();
         const Bird* GetBird() const;
         b2World* getWorld();
@@ -57,26 +93,59 @@ class World {
         void handleBirdState();
         void handleObjectState();
         void useBirdPower();
+        void launchBird(float direction, float power);
     private:
         b2World *world_;
         b2Vec2 gravity_;
         std::list<Object *> objects_;
         std::list<Bird *> birds_;
+        // Removed objects and birds are kept with disabled bodies, so restoring a state doesn't recreate them
+        std::list<Object *> removedObjects_;
+        std::list<Bird *> removedBirds_;
+        // List nodes in load order, they stay valid while the nodes move between the lists above
+        std::vector<std::list<Object *>::iterator> objectNodes_;
+        std::vector<std::list<Bird *>::iterator> birdNodes_;
+        WorldState levelStartState_;
+        WorldState shotState_; // State before the last shot
         std::string levelName_;
         int levelIndex_ = 0;
         Cannon *cannon_;
-        sf::RectangleShape background_;
+        ParallaxBackground background_;
         int totalPigCount_ = 0;
         int totalBirdCount_ = 0;
         std::string fileName_;
         Score scoreManager_;
         std::weak_ptr<Player> player_; // Ownership of player is managed by UserSelector;
-        void drawRemainingCounts(sf::RenderWindow &window) const;
+        void drawRemainingCounts(RenderQueue& window) const;
         std::list<SfObject> sfObjects_;
         LevelLoader levelLoader_;
+        // State produced by the physics thread for the snapshots
+        TrajectoryCache trajectoryCache_;
+        TrajectoryPath trajectory_;
+        bool isSettled_ = false;
+        std::array<float, 4> phaseTimes_ = {};
+        PhysicsStats physicsStats_;
+        BlastEngine blasts_;
+        BodyLodManager lod_;
+        void updateLod();
+        ChunkStreamer chunks_; // Chunks of levels wider than WORLD_WIDTH
+        std::vector<ChunkObject> chunkObjects_; // Objects of the chunk being created, reused between chunks
+        float cameraX_ = 0; // Camera center in Box2D units, sent by the main thread
+        void updateChunks();
+        void createChunkObjects(size_t i);
+        SpscQueue<WorldEvent, 1024> events_; // Removed objects, pushed by the physics thread and applied to the HUD by the main thread
+        FragmentPool fragments_; // Pieces of destroyed walls, only used by the physics thread while it runs
+        ParticleSystem particles_; // Destruction effects, only used by the main thread
+        SpscQueue<ImpactEvent, 256> impacts_; // Strongest impacts of each step, pushed by the physics thread and played by the main thread
+        ImpactListener impactListener_{impacts_};
+        sf::Vector2f listenerPosition_; // Camera center the impact sounds are heard from
+        void clearImpacts();
+        void pushRemovedEvent(const Object& object, int score);
         friend class LevelLoader;
         std::list<Object*>::iterator removeObject(std::list<Object*>::iterator it);
         void removeBird();
+        template <typename T>
+        void restoreObjects(std::list<T*>& active, std::list<T*>& removed, const std::vector<typename std::list<T*>::iterator>& nodes, const std::vector<ObjectState>& states);
 };
 
 #endif // WORLD_HPP
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef WORLD_SNAPSHOT_HPP
+#define WORLD_SNAPSHOT_HPP
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "frame_profiler.hpp"
+#include "trajectory.hpp"
+
+/**
+ * @brief Input sent from the main thread to the physics thread
+ *
+ * @param type The action to apply to the world
+ * @param direction Cannon direction in degrees, used by Aim and Launch
+ * @param power Cannon power, used by Aim and Launch
+ * @param key Pressed key, used by KeyPress
+ * @param cameraX Camera center in Box2D units, used by Camera
+ */
+struct WorldCommand {
+    enum class Type {
+        Aim,
+        Launch,
+        UsePower,
+        KeyPress,
+        Camera
+    };
+    Type type = Type::Aim;
+    float direction = 0;
+    float power = 0;
+    sf::Keyboard::Key key = sf::Keyboard::Key::Unknown;
+    float cameraX = 0;
+};
+
+/**
+ * @brief Object removal sent from the physics thread to the main thread, which updates the HUD
+ *
+ * @param type Type of the removed object as returned by Object::getTypeAsChar
+ * @param score Score gained from the removal
+ * @param position Position of the removed object in SFML coordinates, where its destruction effects are emitted
+ * @param size Size of the removed object in pixels
+ */
+struct WorldEvent {
+    char type = 0;
+    int score = 0;
+    sf::Vector2f position;
+    float size = 0;
+};
+
+/**
+ * @brief Collision impact sent from the physics thread to the main thread, which plays its sound
+ *
+ * @param type Sound of the impact, W for a wall, P for a pig and B for a bird
+ * @param position Position of the impact in SFML coordinates
+ * @param impulse Largest normal impulse of the impact
+ */
+struct ImpactEvent {
+    char type = 0;
+    sf::Vector2f position;
+    float impulse = 0;
+};
+
+/**
+ * @brief Immutable state of the world published by the physics thread after every tick
+ *
+ * @param sprites Sprites of the awake objects, the wall fragments and the bird in draw order
+ * @param staticSprites Sprites of the sleeping and static objects, drawn into the cached static layer
+ * @param staticKey Hash of the render keys of the static objects, the cached layer is rendered again when it changes
+ * @param hasBird Whether there is a bird left
+ * @param isBirdLaunched Whether the current bird has been launched
+ * @param isBirdMoving Whether the launched bird is still moving, the camera follows it
+ * @param birdPosition Position of the current bird in SFML coordinates
+ * @param isSettled Whether the level has ended and everything has stopped moving
+ * @param trajectory Predicted path of the bird for the latest aim
+ * @param phaseTimes Milliseconds spent in the Step, Collisions, ObjectState and BirdState phases of the tick
+ * @param physicsStats Box2D profile and counts of the tick
+ */
+struct WorldSnapshot {
+    std::vector<sf::Sprite> sprites;
+    std::vector<sf::Sprite> staticSprites;
+    uint64_t staticKey = 0;
+    bool hasBird = false;
+    bool isBirdLaunched = false;
+    bool isBirdMoving = false;
+    sf::Vector2f birdPosition;
+    bool isSettled = false;
+    TrajectoryPath trajectory;
+    std::array<float, 4> phaseTimes = {};
+    PhysicsStats physicsStats;
+};
+
+#endif // WORLD_SNAPSHOT_HPP
@@ -0,0 +1,84 @@
+#include "level_baker.hpp"
+#include "utils.hpp"
+#include <fstream>
+#include <iostream>
+
+/*
+ * Settles existing levels in place.
+ *
+ * Usage: ab_bake [--seconds N] [FILE|DIR]...
+ *
+ * Bakes the given level files, or every level in the given directories.
+ * Without arguments the levels next to the executable are baked.
+ * Levels that don't settle within N simulated seconds are left unchanged.
+ * Exit code is 0 when every level was baked, 1 when some level failed and 2 on invalid arguments.
+ */
+
+namespace {
+    void printUsage() {
+        std::cerr << "Usage: ab_bake [--seconds N] [FILE|DIR]..." << std::endl;
+    }
+
+    bool bakeFile(const LevelBaker& baker, const fs::path& file) {
+        std::ifstream inFile(file);
+        if (!inFile.is_open()) {
+            throw std::runtime_error("Failed to open file: " + file.string());
+        }
+        json levelJson;
+        inFile >> levelJson;
+        inFile.close();
+        if (!baker.bake(levelJson)) {
+            return false;
+        }
+        std::ofstream outFile(file);
+        if (!outFile.is_open()) {
+            throw std::runtime_error("Failed to open file for writing: " + file.string());
+        }
+        outFile << levelJson.dump(4);
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    float seconds = 10.f;
+    std::vector<fs::path> files;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--seconds" && i + 1 < argc) {
+                seconds = std::stof(argv[++i]);
+            } else if (arg.rfind("--", 0) == 0) {
+                printUsage();
+                return 2;
+            } else {
+                utils::collectLevelFiles(arg, files);
+            }
+        }
+    } catch (const std::exception& e) {
+        printUsage();
+        return 2;
+    }
+    if (files.empty() && argc == 1) {
+        utils::collectLevelFiles(utils::getExecutablePath() + "/assets/levels", files);
+    }
+    if (files.empty()) {
+        std::cerr << "No levels to bake" << std::endl;
+        return 2;
+    }
+
+    LevelBaker baker(seconds);
+    int failedCount = 0;
+    for (const auto& file : files) {
+        try {
+            if (bakeFile(baker, file)) {
+                std::cerr << file.filename().string() << ": baked" << std::endl;
+                continue;
+            }
+            std::cerr << file.filename().string() << ": did not settle within " << seconds << " seconds" << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << file.filename().string() << ": " << e.what() << std::endl;
+        }
+        failedCount++;
+    }
+    return failedCount == 0 ? 0 : 1;
+}
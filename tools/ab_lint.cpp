@@ -0,0 +1,108 @@
+#include "level_validator.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+/*
+ * Headless level validator.
+ *
+ * Usage: ab_lint [--seconds N] [--threads N] [--report FILE] [FILE|DIR]...
+ *
+ * Validates the given level files, or every level in the given directories.
+ * Without arguments the levels next to the executable are validated.
+ * The json report is written to FILE or to stdout, a summary is written to stderr.
+ * Exit code is 0 when every level is valid, 1 when some level has issues and 2 on invalid arguments.
+ */
+
+namespace {
+    void printUsage() {
+        std::cerr << "Usage: ab_lint [--seconds N] [--threads N] [--report FILE] [FILE|DIR]..." << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    float seconds = 5.f;
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::string reportPath;
+    std::vector<fs::path> files;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if ((arg == "--seconds" || arg == "--threads" || arg == "--report") && i + 1 < argc) {
+                std::string value = argv[++i];
+                if (arg == "--seconds") {
+                    seconds = std::stof(value);
+                } else if (arg == "--threads") {
+                    threadCount = std::max(1, std::stoi(value));
+                } else {
+                    reportPath = value;
+                }
+            } else if (arg.rfind("--", 0) == 0) {
+                printUsage();
+                return 2;
+            } else {
+                utils::collectLevelFiles(arg, files);
+            }
+        }
+    } catch (const std::exception& e) {
+        printUsage();
+        return 2;
+    }
+    if (files.empty() && argc == 1) {
+        utils::collectLevelFiles(utils::getExecutablePath() + "/assets/levels", files);
+    }
+    if (files.empty()) {
+        std::cerr << "No levels to validate" << std::endl;
+        return 2;
+    }
+
+    // Each worker takes the next unvalidated level, reports are stored in file order
+    LevelValidator validator(seconds);
+    std::vector<LevelReport> reports(files.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < files.size(); i = next++) {
+            try {
+                reports[i] = validator.validate(files[i]);
+            } catch (const std::exception& e) {
+                reports[i].file = files[i].filename().string();
+                reports[i].issues.push_back({"stability", std::string("Simulation failed: ") + e.what()});
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    threadCount = std::min<unsigned int>(threadCount, files.size());
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    int invalidCount = 0;
+    for (const auto& report : reports) {
+        if (!report.isValid()) {
+            invalidCount++;
+            for (const auto& issue : report.issues) {
+                std::cerr << report.file << ": [" << issue.check << "] " << issue.message << std::endl;
+            }
+        }
+    }
+    std::cerr << files.size() - invalidCount << "/" << files.size() << " levels valid" << std::endl;
+
+    json reportJson = reports;
+    if (reportPath.empty()) {
+        std::cout << reportJson.dump(4) << std::endl;
+    } else {
+        std::ofstream outFile(reportPath);
+        if (!outFile.is_open()) {
+            std::cerr << "Failed to open report file: " << reportPath << std::endl;
+            return 2;
+        }
+        outFile << reportJson.dump(4) << std::endl;
+    }
+    return invalidCount == 0 ? 0 : 1;
+}